@@ -19,6 +19,9 @@ Arguments::Arguments(int mArgc, char** mArgv) {
 
     this->runTraining = false;
     this->trainingDatasetPath = "";
+    this->runConversion = false;
+    this->conversionSrcPath = "";
+    this->conversionDstPath = "";
 
     this->suh = false;
     this->stentiford = false;
@@ -27,6 +30,9 @@ Arguments::Arguments(int mArgc, char** mArgv) {
     this->scale = false;
     this->whRatio = false;
     this->threshold = false;
+    this->seed = false;
+    this->frontier = false;
+    this->shifted = false;
 
     this->width = 0;
     this->height = 0;
@@ -34,6 +40,12 @@ Arguments::Arguments(int mArgc, char** mArgv) {
     this->wRatio = 0;
     this->hRatio = 0;
     this->suhThreshold = 0.0f;
+    this->searchMode = SEARCH_DEFAULT;
+    this->seedValue = 0;
+    this->topK = 1;
+    this->refine = 0;
+    this->samples = 0;
+    this->modelPath = "";
 
     this->imgPath = "";
     this->argc = mArgc;
@@ -63,16 +75,44 @@ void Arguments::parse() {
             std::cerr << "Undefined path of training dataset!" << std::endl;
             this->allClear = false;
         }
+        else if (std::string(this->argv[1]) == "-convert" || std::string(this->argv[1]) == "convert") {
+            std::cerr << "Undefined paths of trained model and binary model file!" << std::endl;
+            this->allClear = false;
+        }
         else { // the first argument must be path of input image
             this->imgPath = this->argv[1];
         }
     }
     else { // more arguments
-        // check if training was specified $ ./autocrop -train path
+        // check if training was specified $ ./autocrop -train path [-seed N]
         if (std::string(this->argv[1]) == "-train" || std::string(this->argv[1]) == "train" || std::string(this->argv[1]) == "-training") {
             this->runTraining = true;
             this->trainingDatasetPath = this->argv[2];
 
+            // seed for random generators could be specified also for training
+            if (this->argc > 4 && (std::string(this->argv[3]) == "-seed" || std::string(this->argv[3]) == "--seed")) {
+                char *endptr;
+                this->seedValue = strtoull(this->argv[4], &endptr, 10);
+                this->seed = (*endptr == '\0');
+                if (!this->seed) {
+                    this->allClear = false;
+                    std::cerr << "Invalid argument of seed!" << std::endl;
+                }
+            }
+
+            return;
+        }
+
+        // check if conversion of trained model was specified $ ./autocrop -convert model.yml model.bin
+        if (std::string(this->argv[1]) == "-convert" || std::string(this->argv[1]) == "convert") {
+            if (this->argc < 4) {
+                std::cerr << "Undefined path of binary model file!" << std::endl;
+                this->allClear = false;
+                return;
+            }
+            this->runConversion = true;
+            this->conversionSrcPath = this->argv[2];
+            this->conversionDstPath = this->argv[3];
             return;
         }
 
@@ -98,11 +138,19 @@ void Arguments::parse() {
             if (actualArg == "-fang" || actualArg == "fang") { // run Fang's auto cropping methods
                 this->fang = true;
             }
+            if (actualArg == "-frontier" || actualArg == "frontier") { // use frontier of saliency energy vs. area in Suh's algorithm
+                this->frontier = true;
+            }
+            if (actualArg == "-shifted" || actualArg == "shifted") { // generate Stentiford's saliency map with image-wide forks
+                this->shifted = true;
+            }
 
 
             // method for cropping ROI with specified width and height
             if (actualArg == "-wh" || actualArg == "wh") { 
                 this->wh = true; // set flag
+                this->width = 0;
+                this->height = 0; // values of previous crop of the same type are not reused
 
                 if (this->argc > (i + 1)) { // save width value
                     char *endptr;
@@ -129,9 +177,12 @@ void Arguments::parse() {
                     std::cerr << "Invalid or undefined arguments of width or height!" << std::endl;
                     return;
                 }
+                if (!this->addTarget(TARGET_WH, this->width, this->height, 0.0f, "wh" + std::string(this->argv[i+1]) + "x" + std::string(this->argv[i+2])))
+                    return;
             }
             else if (actualArg == "-scale" || actualArg == "scale") { // method for cropping ROI with specified scale factor
                 this->scale = true; // set flag
+                this->scaleValue = 0.0f; // values of previous crop of the same type are not reused
 
                 // save scale factor value
                 if (this->argc > (i + 1)) {
@@ -150,9 +201,13 @@ void Arguments::parse() {
                     std::cerr << "Invalid or undefined argument of scale value! It should be float in range (0;1)." << std::endl;
                     return;
                 }
+                if (!this->addTarget(TARGET_SCALE, 0, 0, this->scaleValue, "scale" + std::string(this->argv[i+1])))
+                    return;
             }
             else if (actualArg == "-whratio" || actualArg == "whratio") { // method for cropping ROI with specified aspect ratio
                 this->whRatio = true; // set flag
+                this->wRatio = 0;
+                this->hRatio = 0; // values of previous crop of the same type are not reused
 
                 // save width value in aspect ratio
                 if (this->argc > (i + 1)) {
@@ -181,6 +236,8 @@ void Arguments::parse() {
                     std::cerr << "Invalid or undefined arguments of width or height ratios!" << std::endl;
                     return;
                 }
+                if (!this->addTarget(TARGET_WHRATIO, this->wRatio, this->hRatio, 0.0f, "whratio" + std::string(this->argv[i+1]) + "x" + std::string(this->argv[i+2])))
+                    return;
             }
             else if (actualArg == "-threshold" || actualArg == "threshold") { // Suh's threshold value is specified
                 this->threshold = true; // set flag
@@ -203,17 +260,143 @@ void Arguments::parse() {
                     return;
                 }
             }
+            else if (actualArg == "-seed" || actualArg == "--seed" || actualArg == "seed") { // seed for random generators
+                this->seed = true; // set flag
+
+                char *endptr = NULL;
+                if (this->argc > (i + 1))
+                    this->seedValue = strtoull(this->argv[i+1], &endptr, 10);
+
+                // check if value was defined successfully
+                if (endptr == NULL || endptr == this->argv[i+1] || *endptr != '\0') {
+                    this->allClear = false;
+                    std::cerr << "Invalid or undefined argument of seed! It should be non-negative integer." << std::endl;
+                    return;
+                }
+            }
+            else if (actualArg == "-topk" || actualArg == "topk") { // number of returned distinct crops
+                char *endptr = NULL;
+                if (this->argc > (i + 1))
+                    this->topK = strtol(this->argv[i+1], &endptr, 10);
+
+                // check if value was defined successfully
+                if (endptr == NULL || endptr == this->argv[i+1] || *endptr != '\0' || this->topK < 1) {
+                    this->allClear = false;
+                    std::cerr << "Invalid or undefined argument of topk! It should be positive integer." << std::endl;
+                    return;
+                }
+            }
+            else if (actualArg == "-refine" || actualArg == "refine") { // number of locally refined candidates
+                char *endptr = NULL;
+                if (this->argc > (i + 1))
+                    this->refine = strtol(this->argv[i+1], &endptr, 10);
+
+                // check if value was defined successfully
+                if (endptr == NULL || endptr == this->argv[i+1] || *endptr != '\0' || this->refine < 0) {
+                    this->allClear = false;
+                    std::cerr << "Invalid or undefined argument of refine! It should be non-negative integer." << std::endl;
+                    return;
+                }
+            }
+            else if (actualArg == "-samples" || actualArg == "samples") { // number of generated windows (sample budget)
+                char *endptr = NULL;
+                if (this->argc > (i + 1))
+                    this->samples = strtol(this->argv[i+1], &endptr, 10);
+
+                // check if value was defined successfully
+                if (endptr == NULL || endptr == this->argv[i+1] || *endptr != '\0' || this->samples < 1) {
+                    this->allClear = false;
+                    std::cerr << "Invalid or undefined argument of samples! It should be positive integer." << std::endl;
+                    return;
+                }
+            }
+            else if (actualArg == "-model" || actualArg == "model") { // trained model of visual composition (.yml or binary file)
+                this->modelPath = (this->argc > (i + 1)) ? std::string(this->argv[i+1]) : "";
+
+                // check if value was defined successfully
+                if (this->modelPath.empty()) {
+                    this->allClear = false;
+                    std::cerr << "Undefined path of trained model!" << std::endl;
+                    return;
+                }
+            }
+            else if (actualArg == "-search" || actualArg == "search") { // mode of searching for the best cropping window
+                std::string mode = (this->argc > (i + 1)) ? std::string(this->argv[i+1]) : "";
+                std::transform(mode.begin(), mode.end(), mode.begin(), ::tolower);
+
+                if (mode == "default")
+                    this->searchMode = SEARCH_DEFAULT;
+                else if (mode == "exact")
+                    this->searchMode = SEARCH_EXACT;
+                else if (mode == "pyramid")
+                    this->searchMode = SEARCH_PYRAMID;
+                else if (mode == "dense")
+                    this->searchMode = SEARCH_DENSE;
+                else if (mode == "importance")
+                    this->searchMode = SEARCH_IMPORTANCE;
+                else {
+                    this->allClear = false;
+                    std::cerr << "Invalid or undefined search mode! Possible values are: default, exact, pyramid, dense, importance." << std::endl;
+                    return;
+                }
+            }
         }
     }
 
-    // arguments -wh -scale -whratio cannot be combined
-    if ((this->wh && this->scale) || (this->wh && this->whRatio) || (this->scale && this->whRatio)) {
-        std::cerr << "Invalid combination of arguments(wh,scale,whRatio)!" << std::endl;
-        this->allClear = false;
+    // arguments -wh -scale -whratio can be combined and repeated, each of them defines one output crop
+    // (without them one crop of general size is made)
+    if (this->targets.empty())
+        this->addTarget(TARGET_GENERAL, 0, 0, 0.0f, "");
+
+    // importance sampling replaces only random generators (crops without defined size, -whratio in Stentiford's algorithm),
+    // crops with -wh or -scale are always searched in grid
+    if (this->searchMode == SEARCH_IMPORTANCE) {
+        for (size_t t = 0; t < this->targets.size(); t++) {
+            if (this->targets[t].type == TARGET_WH || this->targets[t].type == TARGET_SCALE) {
+                this->allClear = false;
+                std::cerr << "Search mode importance cannot be combined with -wh or -scale!" << std::endl;
+                return;
+            }
+            if (this->targets[t].type == TARGET_WHRATIO && (this->suh || this->fang || !this->stentiford)) {
+                this->allClear = false;
+                std::cerr << "Search mode importance can be combined with -whratio only in Stentiford's algorithm(-sten)!" << std::endl;
+                return;
+            }
+        }
     }
 }
 
 
+/**
+ * Function for saving one requested crop
+ * @param type Type of crop
+ * @param w Width of ROI or width value in aspect ratio
+ * @param h Height of ROI or height value in aspect ratio
+ * @param s Scale factor
+ * @param label Label of crop used in names of output files
+ * @return True if crop was saved, False if the same crop was already requested (its output files would be overwritten)
+ */
+bool Arguments::addTarget(TargetType type, int w, int h, float s, std::string label) {
+    for (size_t t = 0; t < this->targets.size(); t++) {
+        const CropTarget& other = this->targets[t];
+        if (other.label == label || (other.type == type && other.width == w && other.height == h && other.scale == s)) {
+            this->allClear = false;
+            std::cerr << "Crop " << label << " is defined more than once!" << std::endl;
+            return false;
+        }
+    }
+
+    CropTarget target;
+    target.type = type;
+    target.width = w;
+    target.height = h;
+    target.scale = s;
+    target.label = label;
+    this->targets.push_back(target);
+    return true;
+}
+
+
 /**
  * Getter function to indicate if there was no error in parsing arguments
  * @return True if there was no error, else False
@@ -362,4 +545,84 @@ int Arguments::getHeightRatio() {
  */
 float Arguments::getThreshold() {
     return this->suhThreshold;
+}
+
+/**
+ * Getter function to indicate if seed for random generators is specified
+ * @return True if seed is specified, else False
+ */
+bool Arguments::isSeed() {
+    return this->seed;
+}
+
+/**
+ * Getter function to indicate if frontier of saliency energy vs. area should be used in Suh's algorithm
+ * @return True if argument -frontier was specified, else False
+ */
+bool Arguments::isFrontier() {
+    return this->frontier;
+}
+
+/**
+ * Getter function to indicate if Stentiford's saliency map should be generated with image-wide forks (faster engine)
+ * @return True if argument -shifted was specified, else False
+ */
+bool Arguments::isShifted() {
+    return this->shifted;
+}
+
+/**
+ * Getter function for seed of random generators
+ * @return Seed value
+ */
+uint64_t Arguments::getSeed() {
+    return this->seedValue;
+}
+
+/**
+ * Getter function for mode of searching for the best cropping window
+ * @return Search mode (SEARCH_DEFAULT if it was not specified)
+ */
+SearchMode Arguments::getSearchMode() {
+    return this->searchMode;
+}
+
+/**
+ * Getter function for number of returned distinct crops for each target
+ * @return Number of crops (1 if it was not specified)
+ */
+int Arguments::getTopK() {
+    return this->topK;
+}
+
+/**
+ * Getter function for number of the best candidates that are locally refined in Fang's algorithm
+ * @return Number of refined candidates (0 if it was not specified)
+ */
+int Arguments::getRefine() {
+    return this->refine;
+}
+
+/**
+ * Getter function for number of generated windows in random methods (sample budget)
+ * @return Number of windows (0 if it was not specified => default of each method)
+ */
+int Arguments::getSamples() {
+    return this->samples;
+}
+
+/**
+ * Getter function for path of trained model of visual composition used in Fang's algorithm
+ * @return Path of model (empty if it was not specified => model compiled into application)
+ */
+std::string Arguments::getModelPath() {
+    return this->modelPath;
+}
+
+/**
+ * Getter function for list of requested crops
+ * @return Crops in order of arguments (one general crop if no size was specified)
+ */
+std::vector<CropTarget> Arguments::getTargets() {
+    return this->targets;
 }
\ No newline at end of file
@@ -11,11 +11,39 @@
 #define __ARGUMENTS_H__
 
 #include <string>
+#include <vector>
 #include <iostream>
 #include <algorithm>
+#include <cstdint>
 
 using namespace std;
 
+/* modes of searching for the best cropping window */
+enum SearchMode {
+    SEARCH_DEFAULT, // default method of each algorithm (grid walk, random generator or greedy algorithm)
+    SEARCH_EXACT,   // exact search (branch-and-bound)
+    SEARCH_PYRAMID, // coarse-to-fine search (fixed width and height or scale)
+    SEARCH_DENSE,   // all positions with stride 1px (fixed width and height or scale)
+    SEARCH_IMPORTANCE // random windows drawn according to saliency map (crop without defined size)
+};
+
+/* types of requested crops */
+enum TargetType {
+    TARGET_GENERAL, // no size was specified
+    TARGET_WH,      // fixed width and height
+    TARGET_SCALE,   // fixed scale factor
+    TARGET_WHRATIO  // fixed aspect ratio
+};
+
+/* one requested crop, more crops of different sizes can be requested in one run */
+struct CropTarget {
+    TargetType type;
+    int width;      // width of ROI or width value in aspect ratio
+    int height;     // height of ROI or height value in aspect ratio
+    float scale;    // scale factor
+    std::string label; // label used in names of output files (e.g. wh600x400, scale0.5, whratio16x9)
+};
+
 class Arguments {
 public:
     // constructor
@@ -26,6 +54,11 @@ public:
     bool runTraining;
     // path of training dataset of images
     std::string trainingDatasetPath;
+    // flag for activate conversion of trained model to binary file
+    bool runConversion;
+    // path of trained model (.yml) and path of binary model file
+    std::string conversionSrcPath;
+    std::string conversionDstPath;
 
     // getters and setters of flags and values
     bool isHelpActivated();
@@ -43,6 +76,9 @@ public:
     bool isScale();
     bool isWHratio();
     bool isThreshold();
+    bool isSeed();
+    bool isFrontier();
+    bool isShifted();
 
     int getWidth();
     int getHeight();
@@ -50,6 +86,13 @@ public:
     int getWidthRatio();
     int getHeightRatio();
     float getThreshold();
+    SearchMode getSearchMode();
+    uint64_t getSeed();
+    int getTopK();
+    int getRefine();
+    int getSamples();
+    std::string getModelPath();
+    std::vector<CropTarget> getTargets();
 
 private:
     void parse();
@@ -67,6 +110,9 @@ private:
     bool scale; // flag if method with specified scale factor should be run
     bool whRatio; // flag if method with specified aspect ratio should be run 
     bool threshold; // flag if threshold used in Suh's algorithm is specified
+    bool seed;  // flag if seed for random generators is specified
+    bool frontier; // flag if Suh's frontier of saliency energy vs. area should be used
+    bool shifted; // flag if Stentiford's saliency map should be generated with image-wide forks
 
     int width;  // width of cropped ROI
     int height; // height of cropped ROI
@@ -74,6 +120,14 @@ private:
     int wRatio; // width value in aspect ratio
     int hRatio; // height value in aspect ratio
     float suhThreshold; // value of saliency threshold
+    SearchMode searchMode; // mode of searching for the best cropping window
+    uint64_t seedValue; // seed for random generators
+    int topK;   // number of returned crops for each target
+    int refine; // number of the best candidates that are locally refined in Fang's algorithm
+    int samples; // number of generated windows in random methods (0 => default of each method)
+    std::string modelPath; // path of trained model of visual composition (empty => model compiled into application)
+    std::vector<CropTarget> targets; // list of requested crops in order of arguments
+    bool addTarget(TargetType type, int w, int h, float s, std::string label);
 };
 
 
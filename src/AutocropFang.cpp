@@ -13,9 +13,9 @@
 * Constructor for cropping algorithm(Fang et al. 2014)
 * @param img Original image to be cropped
 * @param sMap Saliency map of original image(Margolin et al. 2013)
-* @param trainedModelPath Filepath for trained Visual Composition model
+* @param trainedModelPath Filepath for trained Visual Composition model (empty => model compiled into application)
 */
-AutocropFang::AutocropFang(cv::Mat img, cv::Mat sMap, std::string trainedModelPath) {
+AutocropFang::AutocropFang(cv::Mat img, cv::Mat sMap, std::string trainedModelPath) : composScorer(this->compos) {
 	this->x = 0;
 	this->y = 0;
 	this->width = img.cols;
@@ -25,10 +25,25 @@ AutocropFang::AutocropFang(cv::Mat img, cv::Mat sMap, std::string trainedModelPa
 	this->salMap = sMap;	// saliency map of original image
 	// normalize saliency map (cv_32F) to matrix CV_8UC1 because of faster access to pixel values
 	cv::normalize(sMap, this->salMapNorm, 0, 255, NORM_MINMAX, CV_8UC1);
+	// summed-area table is computed only once, every ROI is then evaluated in O(1)
+	this->integral.compute(this->salMapNorm);
+	// summed-area table of saliency map CV_32F for features of visual composition model
+	this->composScorer.compute(this->salMap);
 	// compute total saliency energy of input image
-	this->totalSaliencyEnergy = this->computeSaliencyEnergy(0, 0, img.cols, img.rows);
+	this->totalSaliencyEnergy = this->integral.total();
 	this->gradient = this->getGradient(img);	// generate image gradient
-	this->compos.loadTrainedModel(trainedModelPath);
+	// prefix sums of gradient in rows and columns, border of every ROI is then evaluated in O(1)
+	this->boundaryScorer.compute(this->gradient, img.cols, img.rows);
+	if (trainedModelPath.empty())
+		this->compos.loadDefaultModel();
+	else
+		this->compos.loadTrainedModel(trainedModelPath);
+	// random generators are initialized with actual time, if seed is not defined
+	this->seed = RandomGenerator::timeSeed();
+	// only the best ROI is searched by default
+	this->topK = 1;
+	// candidates are not refined by default
+	this->refineCount = 0;
 }
 
 
@@ -44,33 +59,12 @@ void AutocropFang::WHCrop(int w, int h, int hStep, int vStep) {
 	if ( w <= 0 || h <= 0 || w >= this->image.cols || h >= this->image.rows || hStep < 1 || vStep < 1)
 		return;
 	
-	// init treshold - find ROI with large content first
-	float treshold = SALIENCY_TRESHOLD_INIT;
-	// vector for saving generated candidates for cropping
-	std::vector<std::array<int, 4>> candidates;
-
 	// save width and height of cropping window
 	this->width = w;
 	this->height = h;
 
-	// values for end of loop
-	int endColumn = this->image.cols - w;
-	int endRow = this->image.rows - h;
-
-	while (candidates.size() < CANDIDATES_COUNT) {  // loop until there will be enough candidate ROIs
-#pragma omp parallel for
-		for (int x1 = 0; x1 < endColumn; x1 += hStep) {
-			for (int y1 = 0; y1 < endRow; y1 += vStep) {
-				// check if candidate ROI has satisfactory saliency energy
-				if (this->candidateContentPreserv(x1, y1, w, h, treshold)) {
-					std::array<int, 4> roi = { x1, y1, w, h };
-#pragma omp critical
-					candidates.push_back(roi);
-				}
-			}
-		}
-		treshold -= 0.1f; // decrease treshold if there was not enough candidate ROIs
-	}
+	// windows with the highest saliency energy (content preservation model)
+	CandidateBatch candidates = this->contentCandidates(w, h, hStep, vStep);
 
 	// find best ROI according to boundary simplicity cue and save values(x, y, width, height)
 	this->getBestCandidate(candidates);
@@ -89,41 +83,108 @@ void AutocropFang::scaleCrop(float scale, int hStep, int vStep) {
 	if (scale < 0.0f || scale >= 1.0f || hStep < 1 || vStep < 1)
 		return;
 
-	// init treshold - find ROI with large content first
-	float treshold = SALIENCY_TRESHOLD_INIT;
-	// vector for saving generated candidates for cropping
-	std::vector<std::array<int, 4>> candidates;
-
 	// apply scale to width and height
 	int w = (int)(this->image.cols * scale);
 	int h = (int)(this->image.rows * scale);
 	this->width = w;
 	this->height = h;
 
-	// values for end of loop
-	int endColumn = this->image.cols - w;
-	int endRow = this->image.rows - h;
-
-	while (candidates.size() < CANDIDATES_COUNT) {  // loop until there will be enough candidate ROIs
-#pragma omp parallel for
-		for (int x1 = 0; x1 < endColumn; x1 += hStep) {
-			for (int y1 = 0; y1 < endRow; y1 += vStep) {
-				// check if candidate ROI has satisfactory saliency energy
-				if (this->candidateContentPreserv(x1, y1, w, h, treshold)) {
-					std::array<int, 4> xy = { x1, y1, w, h };
-#pragma omp critical
-					candidates.push_back(xy);
-				}
-			}
-		}
-		treshold -= 0.1f; // decrease treshold if there was not enough candidate ROIs
-	}
+	// windows with the highest saliency energy (content preservation model)
+	CandidateBatch candidates = this->contentCandidates(w, h, hStep, vStep);
 
 	// find best ROI according to boundary simplicity cue and save values(x, y, width, height)
 	this->getBestCandidate(candidates);
 }
 
 
+/**
+* Method for finding optimal cropping window with defined width and height using coarse-to-fine search.
+* Candidates are the windows with the highest saliency energy found with 1px precision, which are at least hStep or vStep apart.
+* @param w Width of cropping window
+* @param h Height of cropping window
+* @param hStep Horizontal step at the coarsest level
+* @param vStep Vertical step at the coarsest level
+*/
+void AutocropFang::pyramidWHCrop(int w, int h, int hStep, int vStep) {
+	// parameter conditions
+	if (w <= 0 || h <= 0 || w >= this->image.cols || h >= this->image.rows || hStep < 1 || vStep < 1)
+		return;
+
+	// save width and height of cropping window
+	this->width = w;
+	this->height = h;
+
+	// the best windows of content preservation model are refined from coarse to fine level
+	PyramidSearch search(this->integral);
+	std::vector<ScoredWindow> best = search.searchWH(w, h, hStep, vStep, CANDIDATES_COUNT);
+	// shifts of the same window by few pixels are not compared by other models (the same spacing as grid of WHCrop)
+	CandidateBatch candidates = this->spacedCandidates(best, hStep, vStep);
+
+	// find best ROI according to boundary simplicity and visual composition models
+	this->getBestCandidate(candidates);
+}
+
+
+/**
+* Method for finding optimal cropping ROI(keeping aspect ratio) using coarse-to-fine search
+* @param scale Zoom factor for cropping window
+* @param hStep Horizontal step at the coarsest level
+* @param vStep Vertical step at the coarsest level
+*/
+void AutocropFang::pyramidScaleCrop(float scale, int hStep, int vStep) {
+	// parameter conditions
+	if (scale <= 0.0f || scale >= 1.0f || hStep < 1 || vStep < 1)
+		return;
+
+	this->pyramidWHCrop((int)(this->image.cols * scale), (int)(this->image.rows * scale), hStep, vStep);
+}
+
+
+/**
+* Method for finding optimal cropping window with defined width and height using dense map of saliency energy.
+* Candidates are the windows with the highest saliency energy from all positions (stride 1px), which are at least hStep or vStep apart.
+* @param w Width of cropping window
+* @param h Height of cropping window
+* @param hStep Minimal horizontal spacing of candidates
+* @param vStep Minimal vertical spacing of candidates
+*/
+void AutocropFang::denseWHCrop(int w, int h, int hStep, int vStep) {
+	// parameter conditions
+	if (w <= 0 || h <= 0 || w >= this->image.cols || h >= this->image.rows || hStep < 1 || vStep < 1)
+		return;
+
+	// save width and height of cropping window
+	this->width = w;
+	this->height = h;
+
+	// saliency energy of all positions computed by running sums, the best window of each hStep x vStep region is kept in pool
+	DenseScoreMap dense(this->salMapNorm);
+	this->scoreMap = dense.computeWH(w, h);
+	TopKWindows pool(CANDIDATES_COUNT, hStep, vStep);
+	DenseScoreMap::bestWindow(this->scoreMap, w, h, pool);
+	// shifts of the same window by few pixels are not compared by other models (the same spacing as grid of WHCrop)
+	CandidateBatch candidates = this->spacedCandidates(pool.sorted(), hStep, vStep);
+
+	// find best ROI according to boundary simplicity and visual composition models
+	this->getBestCandidate(candidates);
+}
+
+
+/**
+* Method for finding optimal cropping ROI(keeping aspect ratio) using dense map of saliency energy
+* @param scale Zoom factor for cropping window
+* @param hStep Minimal horizontal spacing of candidates
+* @param vStep Minimal vertical spacing of candidates
+*/
+void AutocropFang::denseScaleCrop(float scale, int hStep, int vStep) {
+	// parameter conditions
+	if (scale <= 0.0f || scale >= 1.0f)
+		return;
+
+	this->denseWHCrop((int)(this->image.cols * scale), (int)(this->image.rows * scale), hStep, vStep);
+}
+
+
 /**
 * Method for finding optimal cropping with defined Width:Height ratio
 * @param w Horizontal parameter for computing width:height ratio
@@ -136,8 +197,8 @@ void AutocropFang::WHratioCrop(int w, int h, int hStep, int vStep) {
 	if (w < 1 || h < 1 || hStep < 1 || vStep < 1)
 		return;
 
-	// vector for saving generated candidates for cropping
-	std::vector<std::array<int, 4>> candidates;
+	// batch for saving generated candidates for cropping
+	CandidateBatch candidates;
 	// init content preservation(saliency) treshold empirically to 0.6
 	const float TRES = 0.6f;
 	// constant for incrementing width or height until enough candidates are generated
@@ -159,18 +220,20 @@ void AutocropFang::WHratioCrop(int w, int h, int hStep, int vStep) {
 		// values for end of loop
 		int endColumn = this->image.cols - tmpW;
 		int endRow = this->image.rows - tmpH;
-
-#pragma omp parallel for
-		for (int x1 = 0; x1 < endColumn; x1 += hStep) {
-			for (int y1 = 0; y1 < endRow; y1 += vStep) {
+		// each row of grid has its own buffer (no locks), buffers are joined in order of rows
+		const int gridRows = (endRow > 0) ? (endRow + vStep - 1) / vStep : 0;
+		std::vector<CandidateBatch> rowCandidates(gridRows);
+
+#pragma omp parallel for schedule(dynamic)
+		for (int r = 0; r < gridRows; r++) {
+			int y1 = r * vStep;
+			for (int x1 = 0; x1 < endColumn; x1 += hStep) {
 				// check if candidate ROI has satisfactory saliency energy
-				if (this->candidateContentPreserv(x1, y1, tmpW, tmpH, TRES)) {
-					std::array<int, 4> xy = { x1, y1, tmpW, tmpH };
-#pragma omp critical
-					candidates.push_back(xy);
-				}
+				if (this->candidateContentPreserv(x1, y1, tmpW, tmpH, TRES))
+					rowCandidates[r].push(x1, y1, tmpW, tmpH);
 			}
 		}
+		this->appendCandidates(candidates, rowCandidates);
 
 		// increment size of ROI
 		if (w > h) {
@@ -184,13 +247,13 @@ void AutocropFang::WHratioCrop(int w, int h, int hStep, int vStep) {
 	}
 
 	// treshold that was set empirically was too high, no ROIs with this ratio were found
-	if (candidates.size() <= 0) {
+	if (candidates.empty()) {
 		std::cerr << "ROI with ratio(width:height) = " << w << ":" << h << " was not found. Treshold for Content preservation model was too high." << std::endl;
 		return;
 	}
 
 	// find best ROI according to boundary simplicity and visual composition models
-	this->getBestCandidate(candidates);
+	this->getBestCandidate(candidates, REFINE_RATIO);
 }
 
 
@@ -211,109 +274,394 @@ void AutocropFang::randomGridCrop() {
 	// values for end of loop
 	int endCol = this->image.cols - minWidth;
 	int endRow = this->image.rows - minHeight;
-	// init temporary variables for width and height
-	int tmpWidth = 0;
-	int tmpHeight = 0;
 
-	// vector for saving generated candidates for cropping
-	std::vector<std::array<int, 4>> candidates;
-	// initialize random number generator
-	srand((unsigned int)time(NULL));
+	// batch for saving generated candidates for cropping
+	CandidateBatch candidates;
 
 	// empirically set treshold for content preservation model to 0.7 (originally it was 0.4, but that very often misses main subjects)
 	const float SAL_TRESHOLD = 0.7f;
 	// number of ROIs that will be generated at each position in grid
 	const int ROI_NUMBER = 3;
 
-	for (int x1 = 0; x1 < endCol; x1 += hGrid) {
+	// each column of grid has its own buffer (no locks), buffers are joined in order of columns
+	const int gridCols = (endCol > 0) ? (endCol + hGrid - 1) / hGrid : 0;
+	std::vector<CandidateBatch> colCandidates(gridCols);
+
+#pragma omp parallel for schedule(dynamic)
+	for (int c = 0; c < gridCols; c++) {
+		int x1 = c * hGrid;
 		for (int y1 = 0; y1 < endRow; y1 += vGrid) {
+			// temporary width and height of ROI
+			int tmpWidth = 0;
+			int tmpHeight = 0;
+			// each position in grid has its own random sequence
+			RandomGenerator rng(this->seed, RANDOM_DOMAIN_FANG_GRID, (uint64_t)y1 * this->image.cols + x1);
 			int i = 0;
 			while (i < ROI_NUMBER) {	// generate defined number ROIs at each location
 				// generate random width and height
-				tmpWidth = rand() % (this->image.cols - x1);
-				tmpHeight = rand() % (this->image.rows - y1);
+				tmpWidth = rng.uniform(this->image.cols - x1);
+				tmpHeight = rng.uniform(this->image.rows - y1);
 				// condition for very small ROIs -> apply minimal size
 				if (tmpWidth < minWidth) tmpWidth = minWidth;
 				if (tmpHeight < minHeight) tmpHeight = minHeight;
 
 				// check if candidate ROI has satisfactory saliency energy
-				if (this->candidateContentPreserv(x1, y1, tmpWidth, tmpHeight, SAL_TRESHOLD)) {
-					std::array<int, 4> xy = { x1, y1, tmpWidth, tmpHeight };
-					candidates.push_back(xy);
-				}
+				if (this->candidateContentPreserv(x1, y1, tmpWidth, tmpHeight, SAL_TRESHOLD))
+					colCandidates[c].push(x1, y1, tmpWidth, tmpHeight);
 				i++;
 			}
 		}
 	}
+	this->appendCandidates(candidates, colCandidates);
 
 	// find best ROI according to boundary simplicity cue and save values(x, y, width, height)
-	this->getBestCandidate(candidates);
+	this->getBestCandidate(candidates, REFINE_FREE);
+}
+
+
+/**
+* Method for finding optimal cropping ROI with random size, ROIs are generated by importance sampling of saliency map,
+* so each ROI covers pixel drawn according to its saliency and less ROIs are rejected by content preservation model
+* @param samples Number of generated ROIs (more samples => better result, but slower)
+*/
+void AutocropFang::importanceCrop(int samples) {
+	// parameter condition
+	if (samples < 1)
+		return;
+
+	// init minimum size of ROI
+	int minWidth = (int)(this->image.cols * MAX_SCALE_FANG);
+	int minHeight = (int)(this->image.rows * MAX_SCALE_FANG);
+	// the same treshold for content preservation model as in randomGridCrop
+	const float SAL_TRESHOLD = 0.7f;
+
+	SaliencySampler sampler(this->integral);
+	// each sample has its own slot (no locks), rejected samples have zero size
+	CandidateBatch candidates;
+	candidates.resize(samples);
+
+#pragma omp parallel for
+	for (int i = 0; i < samples; i++) {
+		// each sample has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_FANG_IMPORTANCE, i);
+		int tmpWidth = minWidth + rng.uniform(this->image.cols - minWidth);
+		int tmpHeight = minHeight + rng.uniform(this->image.rows - minHeight);
+		// position of ROI covers salient pixel
+		int tmpX, tmpY;
+		if (!sampler.sampleWindow(rng, tmpWidth, tmpHeight, tmpX, tmpY))
+			continue;
+
+		// check if candidate ROI has satisfactory saliency energy
+		if (this->candidateContentPreserv(tmpX, tmpY, tmpWidth, tmpHeight, SAL_TRESHOLD))
+			candidates.set(i, tmpX, tmpY, tmpWidth, tmpHeight);
+	}
+
+	// accepted samples in order of samples (the same candidates for any number of threads)
+	candidates.removeEmpty();
+
+	// find best ROI according to boundary simplicity cue and save values(x, y, width, height)
+	this->getBestCandidate(candidates, REFINE_FREE);
+}
+
+
+/**
+* Method for joining candidates found by parallel loop, each part(e.g. row of grid) was filled independently
+* and parts are appended in their order, so candidates are in the same order as in serial loop for any number of threads
+* @param candidates Batch of candidates to which parts are appended
+* @param parts Candidates of each part
+*/
+void AutocropFang::appendCandidates(CandidateBatch& candidates, const std::vector<CandidateBatch>& parts) {
+	int count = candidates.size();
+	for (size_t i = 0; i < parts.size(); i++)
+		count += parts[i].size();
+	candidates.reserve(count);
+
+	for (size_t i = 0; i < parts.size(); i++)
+		candidates.append(parts[i]);
 }
 
 
 /**
 * Method for computing scores from Boundary simplicity and Visual composition models and finds best cropping ROI
-* @param candidates Vector of cropping candidate ROIs
+* Both models score whole batch at once, orders of candidates in both models are found by sorting.
+* @param candidates Batch of cropping candidate ROIs (score columns of both models are filled)
+* @param mode Degrees of freedom of ROI in local refinement of the best candidates (used only if refinement is enabled)
 */
-void AutocropFang::getBestCandidate(std::vector<std::array<int, 4>> candidates) {
+void AutocropFang::getBestCandidate(CandidateBatch& candidates, RefineMode mode) {
+	const int count = candidates.size();
 	int bestIndex = 0;	// init index of best candidate
-	int bestOrder = INT32_MAX;	//  
-	std::vector<float> boundaryScore;
-	std::vector<float> composScore;
-	std::vector<int> boundaryOrder;
-	std::vector<int> composOrder;
-
-	for (int i = 0; i < candidates.size(); i++) {
-		/* Boundary Simplicity Part */
-		boundaryScore.push_back(this->computeBoundarySimplicity(std::get<0>(candidates.at(i)),
-			std::get<1>(candidates.at(i)),
-			std::get<2>(candidates.at(i)),
-			std::get<3>(candidates.at(i))));
-
-		/* Visual Composition Part */
-		composScore.push_back(this->computeVisualComposition(std::get<0>(candidates.at(i)),
-			std::get<1>(candidates.at(i)),
-			std::get<2>(candidates.at(i)),
-			std::get<3>(candidates.at(i))));
+	int bestOrder = INT32_MAX;	// the lowest weighted sum of orders
+
+	/* Boundary Simplicity Part */
+	this->boundaryScorer.score(candidates);
+	/* Visual Composition Part - model is evaluated once for all candidates */
+	this->composScorer.score(candidates);
+
+	// lower value means better result in both models, weight of normalized model is applied to order
+	std::vector<int> boundaryOrder = this->computeOrders(candidates.boundary, WEIGHT_BOUNDARY);
+	std::vector<int> composOrder = this->computeOrders(candidates.composition, WEIGHT_COMPOS);
+
+	for (int i = 0; i < count; i++) {
+		if (bestOrder > (boundaryOrder[i] + composOrder[i])) {
+			bestOrder = boundaryOrder[i] + composOrder[i];
+			bestIndex = i;
+		}
+
+		// lower sum of orders means better candidate => score of other crops is negative sum
+		this->topWindows.push(candidates.window(i, -(double)(boundaryOrder[i] + composOrder[i])));
+	}
+
+	// save coordinates of top left corner => bestIndex was saved above
+	if (count > 0) {
+		this->x = candidates.x[bestIndex];
+		this->y = candidates.y[bestIndex];
+		this->width = candidates.width[bestIndex];
+		this->height = candidates.height[bestIndex];
+	}
+
+	// the best candidates are moved to local optimum of combined score
+	if (count > 0 && this->refineCount > 0) {
+		std::vector<int> orderSum(count);
+		for (int i = 0; i < count; i++)
+			orderSum[i] = boundaryOrder[i] + composOrder[i];
+		this->refineCandidates(candidates, orderSum, mode);
+	}
+}
+
+
+/**
+* Method for local refinement of the best candidates (pattern search of x, y, width and height).
+* Orders of candidates cannot be computed for new ROIs, so both scores are standardized by mean and standard deviation
+* of all candidates and combined with the same weights as orders. Refined ROI has to keep at least the lowest saliency
+* energy of candidates (content preservation model). Each step scores all moves by actual step as one batch and goes
+* to the best one, if no move is better, step is halved. The best refined candidate is saved as ROI.
+* @param candidates Batch of cropping candidate ROIs with scores of both models (content column is filled)
+* @param orderSum Weighted sums of orders of candidates (refined are the candidates with the lowest sum)
+* @param mode Degrees of freedom of ROI (position, position and size with the same aspect ratio, position and size)
+*/
+void AutocropFang::refineCandidates(CandidateBatch& candidates, const std::vector<int>& orderSum, RefineMode mode) {
+	const int count = candidates.size();
+	const std::vector<double>& boundaryScore = candidates.boundary;
+	const std::vector<double>& composScore = candidates.composition;
+
+	// mean and standard deviation of scores of both models
+	double meanB = 0.0, meanC = 0.0;
+	for (int i = 0; i < count; i++) {
+		meanB += boundaryScore[i];
+		meanC += composScore[i];
+	}
+	meanB /= count;
+	meanC /= count;
+	double devB = 0.0, devC = 0.0;
+	for (int i = 0; i < count; i++) {
+		devB += (boundaryScore[i] - meanB) * (boundaryScore[i] - meanB);
+		devC += (composScore[i] - meanC) * (composScore[i] - meanC);
 	}
+	devB = std::sqrt(devB / count);
+	devC = std::sqrt(devC / count);
+	if (devB <= 0.0) devB = 1.0;
+	if (devC <= 0.0) devC = 1.0;
+
+	// the lowest ratio of saliency energy of candidates
+	SaliencyScorer contentScorer(this->integral, SALIENCY_RATIO);
+	contentScorer.score(candidates);
+	const double minContent = *std::min_element(candidates.content.begin(), candidates.content.end());
+
+	// minimum size of ROI (refined ROI is not smaller than minimum size of Fang's ROIs or than all candidates)
+	int minWidth = (int)(this->image.cols * MAX_SCALE_FANG);
+	int minHeight = (int)(this->image.rows * MAX_SCALE_FANG);
+	for (int i = 0; i < count; i++) {
+		minWidth = std::min(minWidth, candidates.width[i]);
+		minHeight = std::min(minHeight, candidates.height[i]);
+	}
+
+	// combined score of candidate in batch (lower value means better ROI)
+	auto cost = [&](const CandidateBatch& batch, int i) -> double {
+		return WEIGHT_BOUNDARY * (batch.boundary[i] - meanB) / devB + WEIGHT_COMPOS * (batch.composition[i] - meanC) / devC;
+	};
+
+	// candidates with the lowest sum of orders are refined
+	std::vector<int> sorted(count);
+	for (int i = 0; i < count; i++)
+		sorted[i] = i;
+	std::stable_sort(sorted.begin(), sorted.end(), [&orderSum](int a, int b) {
+		return orderSum[a] < orderSum[b];
+	});
+	const int seeds = std::min(this->refineCount, count);
+
+	ScoredWindow best;
+#pragma omp parallel for schedule(dynamic) reduction(bestWindow : best)
+	for (int s = 0; s < seeds; s++) {
+		const int seed = sorted[s];
+		int x1 = candidates.x[seed], y1 = candidates.y[seed], w = candidates.width[seed], h = candidates.height[seed];
+		double value = cost(candidates, seed);
+		CandidateBatch moves;
+
+		int step = std::max(1, std::min(w, h) / REFINE_STEP_DIVISOR);
+		for (int it = 0; it < REFINE_MAX_ITERATIONS && step >= 1; it++) {
+			// moves of position
+			moves.clear();
+			moves.push(x1 - step, y1, w, h);
+			moves.push(x1 + step, y1, w, h);
+			moves.push(x1, y1 - step, w, h);
+			moves.push(x1, y1 + step, w, h);
+			// moves of size (centre of ROI stays)
+			if (mode == REFINE_FREE) {
+				moves.push(x1 - step / 2, y1, w + step, h);
+				moves.push(x1 + step / 2, y1, w - step, h);
+				moves.push(x1, y1 - step / 2, w, h + step);
+				moves.push(x1, y1 + step / 2, w, h - step);
+			}
+			else if (mode == REFINE_RATIO) {
+				for (int sign = -1; sign <= 1; sign += 2) {
+					int newW = w + sign * step;
+					int newH = (int)std::lround((double)newW * candidates.height[seed] / candidates.width[seed]);
+					moves.push(x1 - (newW - w) / 2, y1 - (newH - h) / 2, newW, newH);
+				}
+			}
 
+			// only ROIs inside of image with minimum size are scored
+			for (int m = 0; m < moves.size(); m++) {
+				if (moves.x[m] < 0 || moves.y[m] < 0 || moves.width[m] < minWidth || moves.height[m] < minHeight ||
+					moves.x[m] + moves.width[m] > this->image.cols || moves.y[m] + moves.height[m] > this->image.rows)
+					moves.width[m] = 0;
+			}
+			moves.removeEmpty();
+			contentScorer.score(moves);
+			this->boundaryScorer.score(moves);
+			this->composScorer.score(moves);
+
+			// go to the best move, or halve the step if no move is better
+			int bestMove = -1;
+			double bestValue = value;
+			for (int m = 0; m < moves.size(); m++) {
+				double moveValue = cost(moves, m);
+				if (moves.content[m] >= minContent && moveValue < bestValue) {
+					bestValue = moveValue;
+					bestMove = m;
+				}
+			}
+
+			if (bestMove < 0) {
+				step /= 2;
+				continue;
+			}
+			x1 = moves.x[bestMove];
+			y1 = moves.y[bestMove];
+			w = moves.width[bestMove];
+			h = moves.height[bestMove];
+			value = bestValue;
+		}
 
-	for (int i = 0; i < boundaryScore.size(); i++) {
-		int order = 1;
-		for (int j = 0; j < boundaryScore.size(); j++) 
-			if (boundaryScore.at(i) > boundaryScore.at(j)) // lower value means better result in BS model
-				order++;
+		best.update(ScoredWindow(-value, x1, y1, w, h));
+	}
 
-		// weight of normalized boundary simplicity model
-		order *= WEIGHT_BOUNDARY;
-		boundaryOrder.push_back(order);
+	// save the best refined ROI
+	if (best.isValid()) {
+		this->x = best.x;
+		this->y = best.y;
+		this->width = best.width;
+		this->height = best.height;
 	}
+}
 
-	for (int i = 0; i < composScore.size(); i++) {
-		int order = 1;
-		for (int j = 0; j < composScore.size(); j++)
-			if (composScore.at(i) > composScore.at(j)) // lower value means better result in VC model
-				order++;
 
-		// weight of normalized visual composition model
-		order *= WEIGHT_COMPOS;
-		composOrder.push_back(order);
+/**
+* Method for computing weighted orders of scores in O(n log n)
+* Order of score = 1 + number of strictly lower scores (candidates with the same score have the same order).
+* @param scores Scores of candidates (lower value means better result)
+* @param weight Weight of model
+* @return Weighted orders in the same order as scores
+*/
+std::vector<int> AutocropFang::computeOrders(const std::vector<double>& scores, int weight) {
+	const int count = (int)scores.size();
+
+	// indexes of candidates sorted by score (stable => the same result for equal scores)
+	std::vector<int> sorted(count);
+	for (int i = 0; i < count; i++)
+		sorted[i] = i;
+	std::stable_sort(sorted.begin(), sorted.end(), [&scores](int a, int b) {
+		return scores[a] < scores[b];
+	});
+
+	std::vector<int> orders(count);
+	int groupStart = 0;
+	for (int k = 0; k < count; k++) {
+		// the first candidate with higher score starts new group of equal scores
+		if (k > 0 && scores[sorted[k - 1]] < scores[sorted[k]])
+			groupStart = k;
+		orders[sorted[k]] = (groupStart + 1) * weight;
 	}
 
-	for (int i = 0; i < candidates.size(); i++) {
-		if (bestOrder > (boundaryOrder.at(i) + composOrder.at(i))) {
-			bestOrder = boundaryOrder.at(i) + composOrder.at(i);
-			bestIndex = i;
+	return orders;
+}
+
+
+/**
+* Method for selecting candidates that are not shifts of better candidate by less than one step of grid.
+* Candidate is kept if each better kept candidate of the same size is at least hStep apart horizontally or vStep vertically.
+* @param windows Windows sorted from the best one
+* @param hStep Minimal horizontal spacing of candidates
+* @param vStep Minimal vertical spacing of candidates
+* @return Kept candidates in the same order
+*/
+CandidateBatch AutocropFang::spacedCandidates(const std::vector<ScoredWindow>& windows, int hStep, int vStep) {
+	CandidateBatch candidates;
+	candidates.reserve((int)windows.size());
+
+	for (size_t i = 0; i < windows.size(); i++) {
+		const ScoredWindow& w = windows[i];
+		bool spaced = true;
+		for (int j = 0; j < candidates.size() && spaced; j++) {
+			if (candidates.width[j] == w.width && candidates.height[j] == w.height &&
+				std::abs(candidates.x[j] - w.x) < hStep && std::abs(candidates.y[j] - w.y) < vStep)
+				spaced = false;
 		}
+
+		if (spaced)
+			candidates.push(w.x, w.y, w.width, w.height);
 	}
 
-	// save coordinates of top left corner => bestIndex was saved above
-	if (candidates.size() > 0) {
-		this->x = std::get<0>(candidates.at(bestIndex));
-		this->y = std::get<1>(candidates.at(bestIndex));
-		this->width = std::get<2>(candidates.at(bestIndex));
-		this->height = std::get<3>(candidates.at(bestIndex));
+	return candidates;
+}
+
+
+/**
+* Method for selecting candidates of content preservation model in one pass through grid.
+* Ratio of saliency energy is computed only once for each window and only CANDIDATES_COUNT windows with the highest ratio are kept.
+* (Lowering treshold from SALIENCY_TRESHOLD_INIT by 0.1 kept every window above the last treshold, often thousands of windows,
+* so boundary simplicity is now ranked on smaller set of candidates and the result may differ.)
+* @param w Width of cropping window
+* @param h Height of cropping window
+* @param hStep Horizontal step - number of pixels in x-axis
+* @param vStep Vertical step - number of pixels in y-axis
+* @return Candidates sorted from the highest saliency energy (content column is filled)
+*/
+CandidateBatch AutocropFang::contentCandidates(int w, int h, int hStep, int vStep) {
+	// values for end of loop
+	int endColumn = this->image.cols - w;
+	int endRow = this->image.rows - h;
+
+	// each thread keeps its own bounded heap of the best windows, heaps are merged at the end
+	TopKWindows pool(CANDIDATES_COUNT);
+#pragma omp parallel for reduction(topWindows : pool)
+	for (int y1 = 0; y1 < endRow; y1 += vStep) {
+		for (int x1 = 0; x1 < endColumn; x1 += hStep) {
+			// ratio of saliency energy cropping ROI/original image
+			double saliencyRatio = (double)this->computeSaliencyEnergy(x1, y1, w, h) / this->totalSaliencyEnergy;
+			pool.push(ScoredWindow(saliencyRatio, x1, y1, w, h));
+		}
 	}
+
+	std::vector<ScoredWindow> best = pool.sorted();
+	CandidateBatch candidates;
+	candidates.reserve((int)best.size());
+	for (int i = 0; i < best.size(); i++) {
+		candidates.push(best.at(i).x, best.at(i).y, w, h);
+		candidates.content.push_back(best.at(i).score);
+	}
+
+	return candidates;
 }
 
 
@@ -331,10 +679,10 @@ bool AutocropFang::candidateContentPreserv(int x1, int y1, int w, int h, float t
 		return false;
 	
 	// compute saliency energy of actual window
-	uint32_t saliencyScore = this->computeSaliencyEnergy(x1, y1, w, h);
+	uint64_t saliencyScore = this->computeSaliencyEnergy(x1, y1, w, h);
 
 	// ratio of saliency energy cropping ROI/original image
-	float saliencyRatio = (float)saliencyScore / this->totalSaliencyEnergy;
+	float saliencyRatio = (float)((double)saliencyScore / this->totalSaliencyEnergy);
 
 	// preserv ROIs with satisfactory saliency energy
 	if (saliencyRatio > treshold)
@@ -352,33 +700,21 @@ bool AutocropFang::candidateContentPreserv(int x1, int y1, int w, int h, float t
  * @param h Height of ROI
  * @return Saliency energy of defined ROI
  */
-uint32_t AutocropFang::computeSaliencyEnergy(int x1, int y1, int w, int h) {
-	uint32_t score = 0;
-
+uint64_t AutocropFang::computeSaliencyEnergy(int x1, int y1, int w, int h) {
 	// right bottom corner of ROI
 	int x2 = x1 + w;
 	int y2 = y1 + h;
 
 	// input condition
+	if (x1 < 0 || y1 < 0)
+		return 0;
 	if (x2 > this->salMapNorm.cols)
 		return 0;
 	if (y2 > this->salMapNorm.rows)
 		return 0;
 
-	uint8_t valPixel = 0;
-	for (int i = x1; i < x2; i++) {
-		for (int j = y1; j < y2; j++) {
-			// get pixel value [0,255]
-			valPixel = this->salMapNorm.data[j * salMap.cols + i];
-			// get pixel value <0, 1>
-			//valPixel = this->salMap.at<float>(j, i);
-
-			// increment score with pixel value
-			score += valPixel;
-		}
-	}
-
-	return score;
+	// O(1) lookup in summed-area table instead of walking through all pixels of ROI
+	return this->integral.sum(x1, y1, w, h);
 }
 
 
@@ -386,11 +722,10 @@ uint32_t AutocropFang::computeSaliencyEnergy(int x1, int y1, int w, int h) {
 /**
 * Method for generating gradient of image -> big values for edges of objects
 * @param img Original image
-* @return Gradient of original image with big values for edges.
+* @return Gradient of original image with big values for edges (at most GRADIENT_MAX_SIZE x GRADIENT_MAX_SIZE)
 */
 cv::Mat AutocropFang::getGradient(cv::Mat img) {
-	Mat src = img.clone();	// copy original image
-	Mat src_gray;	// mat for converting original to gray
+	Mat src_gray;	// gray image at working resolution
 	Mat grad;	// final gradient image (output)
 	int scale = 1;
 	int delta = 0;
@@ -404,11 +739,24 @@ cv::Mat AutocropFang::getGradient(cv::Mat img) {
 		sigma = 5;
 	else if (img.cols >= 1200 || img.rows >= 1200)
 		sigma = 3;
-	// apply a GaussianBlur to our image to reduce the noise
-	cv::GaussianBlur(src, src, Size(0, 0), sigma, sigma, BORDER_DEFAULT);
 
-	// Convert it to gray
-	cv::cvtColor(src, src_gray, CV_BGR2GRAY);
+	// Convert it to gray first (conversion and blur are linear => only one channel is blurred, original is not copied)
+	cv::cvtColor(img, src_gray, CV_BGR2GRAY);
+
+	// reduce image to working resolution, every level of pyramid blurs image by gaussian with sigma 1px (of its level)
+	double variance = (double)sigma * sigma;	// variance of blur that remains (in pixels of original image)
+	double levelScale = 1.0;	// size of pixel at actual level (in pixels of original image)
+	while (src_gray.cols > GRADIENT_MAX_SIZE || src_gray.rows > GRADIENT_MAX_SIZE) {
+		cv::pyrDown(src_gray, src_gray);
+		variance -= levelScale * levelScale;
+		levelScale *= 2.0;
+	}
+
+	// apply a GaussianBlur with the remaining sigma to reduce the noise
+	if (variance > 0.0) {
+		double workSigma = std::sqrt(variance) / levelScale;
+		cv::GaussianBlur(src_gray, src_gray, Size(0, 0), workSigma, workSigma, BORDER_DEFAULT);
+	}
 
 	// Generate grad_x and grad_y
 	Mat grad_x, grad_y;
@@ -431,85 +779,6 @@ cv::Mat AutocropFang::getGradient(cv::Mat img) {
 }
 
 
-/**
- * Method for computing boundary simplicity value of selected ROI
- * @param x1 Horizontal coordinate(x-axis) of ROI top left corner
- * @param y1 Vertical coordinate(y-axis) of ROI top left corner
- * @param w Width of ROI
- * @param h Height of ROI
- * @return Boundary simplicity value of defined ROI
- */
-float AutocropFang::computeBoundarySimplicity(int x1, int y1, int w, int h) {
-	uint32_t score = 0;
-	uint32_t pixels = 0;
-
-	// right bottom corner of ROI
-	int x2 = x1 + w - 1;
-	int y2 = y1 + h - 1;
-
-	// input condition
-	if (this->gradient.cols <= x2)
-		return 0;
-	if (this->gradient.rows <= y2)
-		return 0;
-
-	for (int i = x1; i < x2; i++) {
-		// increment score with pixel value [0,255]
-		// top bound (2 pixels wide)
-		score += (uint8_t)this->gradient.data[y1 * this->gradient.cols + i];
-		score += (uint8_t)this->gradient.data[(y1 + 1) * this->gradient.cols + i];
-		// bottom bound (2 pixels wide)
-		score += (uint8_t)this->gradient.data[(y2 - 1) * this->gradient.cols + i];
-		score += (uint8_t)this->gradient.data[y2 * this->gradient.cols + i];
-		
-		// increment number of pixels
-		pixels += 4;
-	}
-
-	for (int j = (y1 + 2); j < (y2 - 2); j++) {
-		// increment score with pixel value [0,255]
-		// left bound (2 pixels wide)
-		score += (uint8_t)this->gradient.data[j * this->gradient.cols + x1];
-		score += (uint8_t)this->gradient.data[j * this->gradient.cols + (x1 + 1)];
-		// right bound (2 pixels wide)
-		score += (uint8_t)this->gradient.data[j * this->gradient.cols + (x2 - 1)];
-		score += (uint8_t)this->gradient.data[j * this->gradient.cols + x2];
-		
-		// increment number of pixels
-		pixels += 4;
-	}
-
-	return (float)score / (float)pixels;
-}
-
-
-/**
-* This methods computes score of ROI in Visual Composition model
-* @param x1 Horizontal coordinate(x-axis) of ROI top left corner
-* @param y1 Vertical coordinate(y-axis) of ROI top left corner
-* @param w Width of ROI
-* @param h Height of ROI
-* @return Visual composition score of defined ROI
-*/
-float AutocropFang::computeVisualComposition(int x1, int y1, int w, int h) {
-	/* vyrazne zpomalovalo - nyni nacitat jen jednou na zacatku
-	CompositionModel comp;
-	comp.loadTrainedModel(this->trainedModelPath);*/
-	
-	// create rectangle of defined ROI
-	cv::Rect rect = cv::Rect(x1, y1, w, h);
-	cv::Mat cropCandidate;
-	cropCandidate = this->salMap(rect);	// crop this ROI
-
-	// compute feature vector(size of 21 or 85)
-	cv::Mat fvec = this->compos.getFeatureVector(cropCandidate);
-	// compute score -> the lowest value means best score
-	float score = this->compos.classifyComposition(fvec);
-
-	return score;
-}
-
-
 /*
 * Getter function for x1 coordinate of cropping ROI (top left corner)
 */
@@ -537,3 +806,62 @@ int AutocropFang::getWidth() {
 int AutocropFang::getHeight() {
 	return this->height;
 }
+
+/*
+* Setter function for seed of random generators (the same seed gives the same crop)
+*/
+void AutocropFang::setSeed(uint64_t seed) {
+	this->seed = seed;
+}
+
+
+/*
+* Method for resetting ROI to whole image (the same instance can be used for more crops, e.g. more targets)
+*/
+void AutocropFang::reset() {
+	this->x = 0;
+	this->y = 0;
+	this->width = this->image.cols;
+	this->height = this->image.rows;
+	this->topWindows.clear();
+	// score map belongs only to the last dense crop
+	this->scoreMap.release();
+}
+
+/*
+* Setter function for number of the best candidates that are locally refined (0 disables refinement)
+*/
+void AutocropFang::setRefine(int count) {
+	this->refineCount = std::max(0, count);
+}
+
+
+/*
+* Setter function for number of returned crops (pool of the best ROIs is kept only if k > 1, one ROI per region of image)
+*/
+void AutocropFang::setTopK(int k) {
+	this->topK = std::max(1, k);
+	// pool keeps only the best window of each region, so it is not filled with small shifts of the best window
+	this->topWindows = TopKWindows((this->topK > 1) ? this->topK * TOPK_POOL_FACTOR : 0,
+		std::max(1, this->image.cols / TOPK_REGIONS), std::max(1, this->image.rows / TOPK_REGIONS));
+}
+
+/*
+* Getter function for the best distinct crops (the first one is final crop, IoU of any two crops is at most TOPK_MAX_IOU)
+*/
+std::vector<cv::Rect> AutocropFang::getTopCandidates() {
+	std::vector<ScoredWindow> first(1, ScoredWindow(0.0, this->x, this->y, this->width, this->height));
+	std::vector<ScoredWindow> windows = this->topWindows.suppress(this->topK, first);
+
+	std::vector<cv::Rect> rois;
+	for (size_t i = 0; i < windows.size(); i++)
+		rois.push_back(cv::Rect(windows[i].x, windows[i].y, windows[i].width, windows[i].height));
+	return rois;
+}
+
+/*
+* Getter function for map of saliency energy of all positions computed by the last dense method (empty if it was not used)
+*/
+cv::Mat AutocropFang::getScoreMap() {
+	return this->scoreMap;
+}
\ No newline at end of file
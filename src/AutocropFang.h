@@ -12,8 +12,19 @@
 
 #include <opencv2/opencv.hpp>
 #include <array>
+#include <cmath>
 #include <algorithm>
 #include "CompositionModel.h"
+#include "SaliencyIntegral.h"
+#include "PyramidSearch.h"
+#include "RandomGenerator.h"
+#include "TopKWindows.h"
+#include "DenseScoreMap.h"
+#include "SaliencySampler.h"
+#include "CandidateBatch.h"
+#include "SaliencyScorer.h"
+#include "BoundaryScorer.h"
+#include "CompositionScorer.h"
 
 using namespace std;
 using namespace cv;
@@ -27,10 +38,21 @@ const int WEIGHT_BOUNDARY = 1;
 
 /* default step when walking trough grid */
 const int DEFAULT_STEP_FANG = 10;
+/* default number of ROIs generated by importance sampling */
+const int IMPORTANCE_SAMPLES_FANG = 3000;
 /* minimum size of roi */
 const float MAX_SCALE_FANG = 0.4f;
 /* value for initializing treshold in Content preservation model */
 const float SALIENCY_TRESHOLD_INIT = 0.8f;
+/* maximal number of steps of local refinement of one candidate */
+const int REFINE_MAX_ITERATIONS = 100;
+/* initial step of local refinement (part of smaller side of ROI) */
+const int REFINE_STEP_DIVISOR = 16;
+/* maximal width and height of gradient image (larger images are reduced by pyramid in Boundary simplicity model) */
+const int GRADIENT_MAX_SIZE = 1024;
+
+/* degrees of freedom of ROI in local refinement of the best candidates */
+enum RefineMode { REFINE_POSITION, REFINE_RATIO, REFINE_FREE };
 
 
 class AutocropFang
@@ -44,25 +66,38 @@ public:
 	void scaleCrop(float scale, int hStep = DEFAULT_STEP_FANG, int vStep = DEFAULT_STEP_FANG);
 	void WHratioCrop(int w, int h, int hStep = DEFAULT_STEP_FANG, int vStep = DEFAULT_STEP_FANG);
 	void randomGridCrop();
+	void importanceCrop(int samples = IMPORTANCE_SAMPLES_FANG);
+	void pyramidWHCrop(int w, int h, int hStep = DEFAULT_STEP_FANG, int vStep = DEFAULT_STEP_FANG);
+	void pyramidScaleCrop(float scale, int hStep = DEFAULT_STEP_FANG, int vStep = DEFAULT_STEP_FANG);
+	void denseWHCrop(int w, int h, int hStep = DEFAULT_STEP_FANG, int vStep = DEFAULT_STEP_FANG);
+	void denseScaleCrop(float scale, int hStep = DEFAULT_STEP_FANG, int vStep = DEFAULT_STEP_FANG);
 	// getters for ROI
 	int getX();
 	int getY();
 	int getWidth();
 	int getHeight();
+	void setSeed(uint64_t seed);
+	void reset();
+	void setTopK(int k);
+	void setRefine(int count);
+	std::vector<cv::Rect> getTopCandidates();
+	cv::Mat getScoreMap();
 	// matrix for gradient image
 	cv::Mat gradient;
 
 private:
 	// computes and normalizes scores of models and selects the best ROI
-	void getBestCandidate(std::vector<std::array<int, 4>> candidates);
+	void getBestCandidate(CandidateBatch& candidates, RefineMode mode = REFINE_POSITION);
+	void refineCandidates(CandidateBatch& candidates, const std::vector<int>& orderSum, RefineMode mode);
+	std::vector<int> computeOrders(const std::vector<double>& scores, int weight);
+	void appendCandidates(CandidateBatch& candidates, const std::vector<CandidateBatch>& parts);
 	// content preservation model methods
+	CandidateBatch contentCandidates(int w, int h, int hStep, int vStep);
+	CandidateBatch spacedCandidates(const std::vector<ScoredWindow>& windows, int hStep, int vStep);
 	bool candidateContentPreserv(int x1, int y1, int w, int h, float treshold);
-	uint32_t computeSaliencyEnergy(int x1, int y1, int w, int h);
+	uint64_t computeSaliencyEnergy(int x1, int y1, int w, int h);
 	// boundary simplicity model methods
 	cv::Mat getGradient(cv::Mat img);
-	float computeBoundarySimplicity(int x1, int y1, int w, int h);
-	// visual composition method for computing score
-	float computeVisualComposition(int x1, int y1, int w, int h);
 
 	// ROI values
 	int x;
@@ -75,11 +110,25 @@ private:
 	cv::Mat salMap;
 	// normalized saliency map to [0,255] CV_8UC1
 	cv::Mat salMapNorm;
+	// summed-area table of normalized saliency map
+	SaliencyIntegral integral;
+	// map of saliency energy of all positions (dense methods)
+	cv::Mat scoreMap;
 
 	// total saliency energy of original image
-	uint32_t totalSaliencyEnergy;
+	uint64_t totalSaliencyEnergy;
 	// instance of visual composition model
 	CompositionModel compos;
+	// scorers of boundary simplicity and visual composition models (batch of candidates at once)
+	BoundaryScorer boundaryScorer;
+	CompositionScorer composScorer;
+	// seed for random generators
+	uint64_t seed;
+	// number of returned crops and pool of the best ROIs
+	int topK;
+	TopKWindows topWindows;
+	// number of the best candidates that are locally refined
+	int refineCount;
 };
 
 #endif //__AUTOCROPFANG_H__
\ No newline at end of file
@@ -19,7 +19,12 @@ AutocropStentiford::AutocropStentiford(cv::Mat sm) {
 	this->width = sm.cols;
 	this->height = sm.rows;
 	this->salMap = sm;
+	this->integral.compute(sm);
 	this->bestScore = 0.0f;
+	// only the best ROI is searched by default
+	this->topK = 1;
+	// random generators are initialized with actual time, if seed is not defined
+	this->seed = RandomGenerator::timeSeed();
 }
 
 /**
@@ -38,13 +43,20 @@ void AutocropStentiford::brutalForceWH(int w, int h, int hStep, int vStep) {
 	int endColumn = this->salMap.cols - w;
 	int endRow = this->salMap.rows - h;
 
-	// Get ROI with the best average attention score
-#pragma omp parallel for
-	for (int xx = 0; xx < endColumn; xx += hStep) {
-		for (int yy = 0; yy < endRow; yy += vStep) {
-			this->computeMaxScore(xx, yy, w, h);
+	// Get ROI with the best average attention score (reduced from private results of each thread)
+	ScoredWindow best;
+	TopKWindows pool = this->topWindows.emptyCopy();
+#pragma omp parallel for reduction(bestWindow : best) reduction(topWindows : pool)
+	for (int yy = 0; yy < endRow; yy += vStep) {
+		for (int xx = 0; xx < endColumn; xx += hStep) {
+			ScoredWindow roi(this->integral.mean(xx, yy, w, h), xx, yy, w, h);
+			best.update(roi);
+			pool.push(roi);
 		}
 	}
+
+	this->saveIfBetter(best);
+	this->topWindows.merge(pool);
 }
 
 
@@ -71,13 +83,105 @@ void AutocropStentiford::brutalForceZoomFactor(float zFactor, int hStep, int vSt
 	int endRow = this->salMap.rows - tmpHeight;
 
 
-	// Get ROI with the best average attention score
-#pragma omp parallel for
-	for (int xx = 0; xx < endColumn; xx += hStep) {
-		for (int yy = 0; yy < endRow; yy += vStep) {
-			this->computeMaxScore(xx, yy, tmpWidth, tmpHeight);
+	// Get ROI with the best average attention score (reduced from private results of each thread)
+	ScoredWindow best;
+	TopKWindows pool = this->topWindows.emptyCopy();
+#pragma omp parallel for reduction(bestWindow : best) reduction(topWindows : pool)
+	for (int yy = 0; yy < endRow; yy += vStep) {
+		for (int xx = 0; xx < endColumn; xx += hStep) {
+			ScoredWindow roi(this->integral.mean(xx, yy, tmpWidth, tmpHeight), xx, yy, tmpWidth, tmpHeight);
+			best.update(roi);
+			pool.push(roi);
 		}
 	}
+
+	this->saveIfBetter(best);
+	this->topWindows.merge(pool);
+}
+
+
+/**
+* Method for finding optimal cropping ROI with selected Width and Height using coarse-to-fine search
+* (grid with hStep and vStep is walked through only at the coarsest level, final position is found with 1px precision)
+* @param w Width of result ROI
+* @param h Height of result ROI
+* @param hStep Size of horizontal step at the coarsest level
+* @param vStep Size of vertical step at the coarsest level
+*/
+void AutocropStentiford::pyramidWH(int w, int h, int hStep, int vStep) {
+	// parameters conditions
+	if (hStep < 1 || vStep < 1 || w <= 0 || h <= 0 || w > this->salMap.cols || h > this->salMap.rows)
+		return;
+
+	PyramidSearch search(this->integral);
+	std::vector<ScoredWindow> best = search.searchWH(w, h, hStep, vStep, std::max(PYRAMID_TOP_K, this->topWindows.getCapacity()));
+
+	// saliency energy of window => average attention score
+	for (size_t i = 0; i < best.size(); i++) {
+		best[i].score /= (double)w * (double)h;
+		this->topWindows.push(best[i]);
+	}
+	if (!best.empty())
+		this->saveIfBetter(best.front());
+}
+
+
+/**
+* Method for finding optimal cropping ROI with selected zoomFactor using coarse-to-fine search
+* @param zFactor Ratio of size original/result
+* @param hStep Size of horizontal step at the coarsest level
+* @param vStep Size of vertical step at the coarsest level
+*/
+void AutocropStentiford::pyramidZoomFactor(float zFactor, int hStep, int vStep) {
+	// parameters conditions
+	if (hStep <= 0 || vStep <= 0 || zFactor <= 1.0)
+		return;
+
+	float scale = 1.0f / zFactor;
+	this->pyramidWH((int)(this->salMap.cols * scale), (int)(this->salMap.rows * scale), hStep, vStep);
+}
+
+
+/**
+* Method for finding optimal cropping ROI with selected Width and Height at every position (stride 1px) using dense map of saliency energy
+* @param w Width of result ROI
+* @param h Height of result ROI
+*/
+void AutocropStentiford::denseWH(int w, int h) {
+	// parameters conditions
+	if (w <= 0 || h <= 0 || w > this->salMap.cols || h > this->salMap.rows)
+		return;
+
+	// saliency energy of all positions computed by running sums
+	DenseScoreMap dense(this->salMap);
+	this->scoreMap = dense.computeWH(w, h);
+	TopKWindows pool = this->topWindows.emptyCopy();
+	ScoredWindow best = DenseScoreMap::bestWindow(this->scoreMap, w, h, pool);
+
+	// saliency energy of window => average attention score (the same area for all windows)
+	std::vector<ScoredWindow> windows = pool.sorted();
+	for (size_t i = 0; i < windows.size(); i++) {
+		windows[i].score /= (double)w * (double)h;
+		this->topWindows.push(windows[i]);
+	}
+	if (best.isValid()) {
+		best.score /= (double)w * (double)h;
+		this->saveIfBetter(best);
+	}
+}
+
+
+/**
+* Method for finding optimal cropping ROI with selected zoomFactor at every position (stride 1px)
+* @param zFactor Ratio of size original/result
+*/
+void AutocropStentiford::denseZoomFactor(float zFactor) {
+	// parameters conditions
+	if (zFactor <= 1.0)
+		return;
+
+	float scale = 1.0f / zFactor;
+	this->denseWH((int)(this->salMap.cols * scale), (int)(this->salMap.rows * scale));
 }
 
 
@@ -130,22 +234,25 @@ void AutocropStentiford::randomWHratio(int w, int h, float maxZoomFactor) {
 		minWidth = (int)(minHeight * w / h);
 	}
 
-	// temporary variables
-	int tmpX, tmpY, tmpWidth, tmpHeight;
+	// each iteration writes its ROI to own slot of batch, the whole batch is then scored at once
+	CandidateBatch candidates;
+	candidates.resize(ITERATIONS);
 
-	srand((unsigned int)time(NULL));
 	// generating random coordinates of top left corner x1,y1 and width(height will be computed)
 #pragma omp parallel for
 	for (int i = 0; i < ITERATIONS; i++) {
-		tmpX = rand() % (this->salMap.cols - minWidth);
-		tmpY = rand() % (this->salMap.rows - minHeight);
-		tmpWidth = rand() % (this->salMap.cols - tmpX);
+		// each iteration has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_WHRATIO, i);
+		int tmpX = rng.uniform(this->salMap.cols - minWidth);
+		int tmpY = rng.uniform(this->salMap.rows - minHeight);
+		int tmpWidth = rng.uniform(this->salMap.cols - tmpX);
 		tmpWidth = (tmpWidth >= minWidth) ? tmpWidth : minWidth;
-		tmpHeight = (int)(tmpWidth * h / w);
-
-		// compute average attention score for actual ROI
-		this->computeMaxScore(tmpX, tmpY, tmpWidth, tmpHeight);
+		int tmpHeight = (int)(tmpWidth * h / w);
+		candidates.set(i, tmpX, tmpY, tmpWidth, tmpHeight);
 	}
+
+	// compute average attention score for all ROIs
+	this->selectBest(candidates);
 }
 
 
@@ -158,9 +265,6 @@ void AutocropStentiford::randomZFWalk(float maxZoomFactor) {
 	if (maxZoomFactor < 1.0f)
 		return;
 	
-	// temporary variables
-	int tmpX, tmpY, tmpWidth, tmpHeight;
-
 	// if parameter zFactor is 1.5(original image is 1.5x bigger) => scale is 0.666(2/3 of original image size)
 	float scale = 1.0f / maxZoomFactor;
 
@@ -170,19 +274,151 @@ void AutocropStentiford::randomZFWalk(float maxZoomFactor) {
 
 	// ratio width/height of original image
 	double aspectRatioHW = (double)this->salMap.rows / (double)this->salMap.cols;
-	srand((unsigned int)time(NULL));
+
+	// each iteration writes its ROI to own slot of batch, the whole batch is then scored at once
+	CandidateBatch candidates;
+	candidates.resize(ITERATIONS);
 
 	// generating random coordinates of top left corner (x1,y1) and width 
 #pragma omp parallel for
 	for (int i = 0; i < ITERATIONS; i++) {
-		tmpX = rand() % (this->salMap.cols - minWidth);
-		tmpY = rand() % (this->salMap.rows - minHeight);
-		tmpWidth = rand() % (this->salMap.cols - tmpX);
+		// each iteration has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_ZF_WALK, i);
+		int tmpX = rng.uniform(this->salMap.cols - minWidth);
+		int tmpY = rng.uniform(this->salMap.rows - minHeight);
+		int tmpWidth = rng.uniform(this->salMap.cols - tmpX);
 		tmpWidth = (tmpWidth >= minWidth) ? tmpWidth : minHeight;
-		tmpHeight = (int)(tmpWidth * aspectRatioHW);
+		int tmpHeight = (int)(tmpWidth * aspectRatioHW);
+		candidates.set(i, tmpX, tmpY, tmpWidth, tmpHeight);
+	}
+
+	// compute average attention score for all ROIs
+	this->selectBest(candidates);
+}
+
+
+/**
+* State of branch-and-bound search = set of ROIs with top left corner in [xLow,xHigh] x [yLow,yHigh]
+* and width in [wLow,wHigh] (height is given by width and aspect ratio)
+*/
+struct SubwindowSet
+{
+	int xLow, xHigh;
+	int yLow, yHigh;
+	int wLow, wHigh;
+	// upper bound of average attention score of all ROIs in this set
+	double bound;
+};
+
+/**
+* Ordering of states in priority queue - state with the highest bound is processed first
+* (ties are broken by position and size, so the search is deterministic)
+*/
+struct SubwindowSetCompare
+{
+	bool operator()(const SubwindowSet& a, const SubwindowSet& b) const {
+		if (a.bound != b.bound) return a.bound < b.bound;
+		if (a.yLow != b.yLow) return a.yLow > b.yLow;
+		if (a.xLow != b.xLow) return a.xLow > b.xLow;
+		return a.wLow > b.wLow;
+	}
+};
+
+
+/**
+* Method for finding ROI with the best average attention score(keeping aspect ratio) over all positions
+* and sizes that satisfy max zoom factor. It is branch-and-bound search in the style of Efficient Subwindow Search:
+* sets of ROIs are split in halves and sets whose upper bound is lower than the best found ROI are never expanded.
+* Upper bound = saliency energy of the largest ROI in set / area of the smallest ROI in set (both O(1) with integral image).
+* @param maxZoomFactor Max limit of zoom factor(prevent very small results)
+*/
+void AutocropStentiford::branchAndBoundZF(float maxZoomFactor) {
+	// parameter condition
+	if (maxZoomFactor < 1.0f)
+		return;
+
+	// if parameter zFactor is 1.5(original image is 1.5x bigger) => scale is 0.666(2/3 of original image size)
+	float scale = 1.0f / maxZoomFactor;
+	const int cols = this->salMap.cols;
+	const int rows = this->salMap.rows;
+
+	// ratio height/width of original image
+	const double aspectRatioHW = (double)rows / (double)cols;
+	// define minimum width, height is always computed from width (the same way as in randomZFWalk)
+	int minWidth = (int)(scale * cols);
+	if (minWidth < 1) minWidth = 1;
+	while (minWidth <= cols && (int)(minWidth * aspectRatioHW) < 1)
+		minWidth++;
+	if (minWidth > cols)
+		return;
+
+	// upper bound of average score for set of ROIs, negative value means there is no valid ROI in set
+	auto upperBound = [&](const SubwindowSet& set) -> double {
+		int minHeight = (int)(set.wLow * aspectRatioHW);
+		// the smallest ROI must fit into saliency map
+		if (set.xLow + set.wLow > cols || set.yLow + minHeight > rows)
+			return -1.0;
+
+		// the largest ROI that covers all ROIs in set
+		int x2 = std::min(cols, set.xHigh + set.wHigh);
+		int y2 = std::min(rows, set.yHigh + (int)(set.wHigh * aspectRatioHW));
+		uint64_t maxEnergy = this->integral.sum(set.xLow, set.yLow, x2 - set.xLow, y2 - set.yLow);
+
+		return (double)maxEnergy / ((double)set.wLow * (double)minHeight);
+	};
+
+	std::priority_queue<SubwindowSet, std::vector<SubwindowSet>, SubwindowSetCompare> queue;
+
+	// initial state contains all valid ROIs
+	SubwindowSet all;
+	all.xLow = 0;
+	all.xHigh = cols - minWidth;
+	all.yLow = 0;
+	all.yHigh = rows - (int)(minWidth * aspectRatioHW);
+	all.wLow = minWidth;
+	all.wHigh = cols;
+	all.bound = upperBound(all);
+	queue.push(all);
+
+	while (!queue.empty()) {
+		SubwindowSet set = queue.top();
+		queue.pop();
+
+		// sizes of intervals
+		int xSpan = set.xHigh - set.xLow;
+		int ySpan = set.yHigh - set.yLow;
+		int wSpan = set.wHigh - set.wLow;
+
+		// set with only one ROI and the highest bound => bound is exact score of this ROI and no other ROI can be better
+		if (xSpan == 0 && ySpan == 0 && wSpan == 0) {
+			int h = (int)(set.wLow * aspectRatioHW);
+			this->saveIfBetter(ScoredWindow(this->integral.mean(set.xLow, set.yLow, set.wLow, h), set.xLow, set.yLow, set.wLow, h));
+			return;
+		}
+
+		// split the largest interval in halves
+		SubwindowSet first = set;
+		SubwindowSet second = set;
+		if (xSpan >= ySpan && xSpan >= wSpan) {
+			first.xHigh = set.xLow + xSpan / 2;
+			second.xLow = first.xHigh + 1;
+		}
+		else if (ySpan >= wSpan) {
+			first.yHigh = set.yLow + ySpan / 2;
+			second.yLow = first.yHigh + 1;
+		}
+		else {
+			first.wHigh = set.wLow + wSpan / 2;
+			second.wLow = first.wHigh + 1;
+		}
 
-		// compute average attention score for actual ROI
-		this->computeMaxScore(tmpX, tmpY, tmpWidth, tmpHeight);
+		// save only sets that contain at least one valid ROI
+		first.bound = upperBound(first);
+		if (first.bound >= 0.0)
+			queue.push(first);
+		second.bound = upperBound(second);
+		if (second.bound >= 0.0)
+			queue.push(second);
 	}
 }
 
@@ -197,67 +433,197 @@ void AutocropStentiford::randomWalk(int minWidth, int minHeight) {
 	if (minWidth <= 0 || minHeight <= 0 || minWidth > this->salMap.cols || minHeight > this->salMap.rows)
 		return;
 	
-	// temporary variables
-	int tmpX, tmpY, tmpWidth, tmpHeight;
-	srand((unsigned int)time(NULL));
+	// each iteration writes its ROI to own slot of batch, the whole batch is then scored at once
+	CandidateBatch candidates;
+	candidates.resize(ITERATIONS);
 
 	// generating random coordinates of top left corner (x1,y1) and also width and height
 #pragma omp parallel for
 	for (int i = 0; i < ITERATIONS; i++) {
-		tmpX = rand() % (int)(this->salMap.cols - minWidth);
-		tmpY = rand() % (int)(this->salMap.rows - minHeight);
-		tmpWidth = rand() % (this->salMap.cols - tmpX);
-		tmpHeight = rand() % (this->salMap.rows - tmpY);
+		// each iteration has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_WALK, i);
+		int tmpX = rng.uniform(this->salMap.cols - minWidth);
+		int tmpY = rng.uniform(this->salMap.rows - minHeight);
+		int tmpWidth = rng.uniform(this->salMap.cols - tmpX);
+		int tmpHeight = rng.uniform(this->salMap.rows - tmpY);
 		// min limit for width and height
 		tmpWidth = (tmpWidth > minWidth) ? tmpWidth : minWidth;
 		tmpHeight = (tmpHeight > minHeight) ? tmpHeight : minHeight;
+		candidates.set(i, tmpX, tmpY, tmpWidth, tmpHeight);
+	}
+
+	// compute average attention score for all ROIs
+	this->selectBest(candidates);
+}
+
+
+/**
+* Method for finding ROI with maximal average attention score, ROIs are generated by importance sampling of saliency map
+* (sizes are the same as in randomZFWalk, but each ROI covers pixel drawn according to its saliency)
+* @param maxZoomFactor Defines minimum size of ROI (if zoom factor is 1.5, ROI is at least 1.5x smaller than original)
+* @param samples Number of generated ROIs (more samples => better result, but slower)
+*/
+void AutocropStentiford::importanceZFWalk(float maxZoomFactor, int samples) {
+	// parameter condition
+	if (maxZoomFactor < 1.0f || samples < 1)
+		return;
+
+	// if parameter zFactor is 1.5(original image is 1.5x bigger) => scale is 0.666(2/3 of original image size)
+	float scale = 1.0f / maxZoomFactor;
+	// define minimum width, height is computed from width
+	int minWidth = (int)(scale * this->salMap.cols);
+	// ratio width/height of original image
+	double aspectRatioHW = (double)this->salMap.rows / (double)this->salMap.cols;
+
+	SaliencySampler sampler(this->integral);
+	// each iteration writes its ROI to own slot of batch, the whole batch is then scored at once
+	CandidateBatch candidates;
+	candidates.resize(samples);
+
+#pragma omp parallel for
+	for (int i = 0; i < samples; i++) {
+		// each iteration has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_IMPORTANCE_ZF, i);
+		int tmpWidth = minWidth + rng.uniform(this->salMap.cols - minWidth + 1);
+		int tmpHeight = (int)(tmpWidth * aspectRatioHW);
+		// position of ROI covers salient pixel
+		int tmpX, tmpY;
+		if (sampler.sampleWindow(rng, tmpWidth, tmpHeight, tmpX, tmpY))
+			candidates.set(i, tmpX, tmpY, tmpWidth, tmpHeight);
+	}
+
+	// compute average attention score for all ROIs
+	this->selectBest(candidates);
+}
+
+
+/**
+* Method for finding ROI with defined aspect ratio(width:height) and maximal average attention score, ROIs are generated
+* by importance sampling of saliency map (sizes are the same as in randomWHratio, but each ROI covers pixel drawn according to its saliency)
+* @param w Horizontal parameter for computing width:height ratio
+* @param h Vertical parameter for computing width:height ratio
+* @param maxZoomFactor Minimal limit of scale(prevent cropping very small ROI)
+* @param samples Number of generated ROIs (more samples => better result, but slower)
+*/
+void AutocropStentiford::importanceWHratio(int w, int h, float maxZoomFactor, int samples) {
+	// parameter conditions
+	if (w < 1 || h < 1 || maxZoomFactor < 1.0f || samples < 1)
+		return;
+
+	// if parameter zFactor is 1.5(original image is 1.5x bigger) => scale is 0.666(2/3 of original image size)
+	float scale = 1.0f / maxZoomFactor;
+
+	// define minimum width and maximum width (ROI with defined ratio must fit into saliency map)
+	int minWidth = (w > h) ? (int)(scale * this->salMap.cols) : (int)(scale * this->salMap.rows) * w / h;
+	int maxWidth = std::min(this->salMap.cols, this->salMap.rows * w / h);
+	if (minWidth < 1 || minWidth > maxWidth)
+		return;
+
+	SaliencySampler sampler(this->integral);
+	// each iteration writes its ROI to own slot of batch, the whole batch is then scored at once
+	CandidateBatch candidates;
+	candidates.resize(samples);
 
-		// apply method for getting roi with random parametres
-		this->computeMaxScore(tmpX, tmpY, tmpWidth, tmpHeight);
+#pragma omp parallel for
+	for (int i = 0; i < samples; i++) {
+		// each iteration has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_IMPORTANCE_WHRATIO, i);
+		int tmpWidth = minWidth + rng.uniform(maxWidth - minWidth + 1);
+		int tmpHeight = (int)(tmpWidth * h / w);
+		// position of ROI covers salient pixel
+		int tmpX, tmpY;
+		if (sampler.sampleWindow(rng, tmpWidth, tmpHeight, tmpX, tmpY))
+			candidates.set(i, tmpX, tmpY, tmpWidth, tmpHeight);
 	}
+
+	// compute average attention score for all ROIs
+	this->selectBest(candidates);
 }
 
 
 /**
 * Method for computing maximal average score in defined ROI
-* @param hStep size of horizontal step
-* @param vStep size of vertical step
+* @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+* @param y1 Vertical coordinate(y-axis) of ROI top left corner
 * @param w Width of result ROI
 * @param h Height of result ROI
 */
 void AutocropStentiford::computeMaxScore(int x1, int y1, int w, int h) {
-	double actualScore = 0.0f;
+	// if actual attention score is better, save this ROI
+	ScoredWindow roi = this->scoreWindow(x1, y1, w, h);
+	this->saveIfBetter(roi);
+	this->topWindows.push(roi);
+}
+
 
+/**
+* Method for computing average attention score of ROI
+* @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+* @param y1 Vertical coordinate(y-axis) of ROI top left corner
+* @param w Width of ROI
+* @param h Height of ROI
+* @return ROI with its average attention score (invalid window if ROI is not inside of saliency map)
+*/
+ScoredWindow AutocropStentiford::scoreWindow(int x1, int y1, int w, int h) {
 	int x2 = x1 + w;
 	int y2 = y1 + h;
 
 	// input condition
+	if (x1 < 0 || y1 < 0 || w <= 0 || h <= 0)
+		return ScoredWindow();
 	if (this->salMap.cols < x2)
-		return;
+		return ScoredWindow();
 	if (this->salMap.rows < y2)
-		return;
+		return ScoredWindow();
 
-	//uint8_t valPixel;
-	for (int i = x1; i < x2; i++) {
-		for (int j = y1; j < y2; j++) {
-			//valPixel = this->salMap.data[j * salMap.cols + i];
-			//valPixel = this->salMap.at<uint8_t>(j, i); // slower
-			
-			// increment score with pixel value [0,255]
-			actualScore += this->salMap.data[j * this->salMap.cols + i];;
-		}
+	// compute average attention score for 1px (O(1) lookup in summed-area table)
+	return ScoredWindow(this->integral.mean(x1, y1, w, h), x1, y1, w, h);
+}
+
+
+/**
+* Method for saving ROI if its average attention score is better than actual best score
+* @param roi Candidate ROI with its average attention score
+*/
+void AutocropStentiford::saveIfBetter(const ScoredWindow& roi) {
+	if (roi.isValid() && roi.score > this->bestScore) {
+		this->bestScore = roi.score;
+		this->x = roi.x;
+		this->y = roi.y;
+		this->width = roi.width;
+		this->height = roi.height;
 	}
+}
 
-	// compute average attention score for 1px
-	actualScore /= (w * h);
-	// if actual attention score is better, save this ROI
-	if (actualScore > this->bestScore) {
-		this->bestScore = actualScore;
-		this->x = x1;
-		this->y = y1;
-		this->width = w;
-		this->height = h;
+
+/**
+ * Method for scoring batch of ROIs by average attention score and saving the best ROI (ROIs out of saliency map are skipped)
+ * @param candidates Batch of ROIs (modified - attention column is filled)
+ */
+void AutocropStentiford::selectBest(CandidateBatch& candidates) {
+	// only ROIs inside of saliency map are scored (the same condition as in scoreWindow)
+	for (int i = 0; i < candidates.size(); i++) {
+		if (candidates.x[i] < 0 || candidates.y[i] < 0 || candidates.x[i] + candidates.width[i] > this->salMap.cols ||
+			candidates.y[i] + candidates.height[i] > this->salMap.rows)
+			candidates.width[i] = 0;
 	}
+	candidates.removeEmpty();
+
+	SaliencyScorer attentionScorer(this->integral, SALIENCY_MEAN);
+	attentionScorer.score(candidates);
+
+	// the best ROI is reduced from private results of each thread
+	ScoredWindow best;
+	TopKWindows pool = this->topWindows.emptyCopy();
+#pragma omp parallel for reduction(bestWindow : best) reduction(topWindows : pool)
+	for (int i = 0; i < candidates.size(); i++) {
+		ScoredWindow roi = candidates.window(i, candidates.attention[i]);
+		best.update(roi);
+		pool.push(roi);
+	}
+
+	this->saveIfBetter(best);
+	this->topWindows.merge(pool);
 }
 
 
@@ -287,4 +653,55 @@ int AutocropStentiford::getWidth() {
 */
 int AutocropStentiford::getHeight() {
 	return this->height;
+}
+
+/*
+* Setter function for seed of random generators (the same seed gives the same crop)
+*/
+void AutocropStentiford::setSeed(uint64_t seed) {
+	this->seed = seed;
+}
+
+/*
+* Method for resetting ROI to whole image (the same instance can be used for more crops, e.g. more targets)
+*/
+void AutocropStentiford::reset() {
+	this->x = 0;
+	this->y = 0;
+	this->width = this->salMap.cols;
+	this->height = this->salMap.rows;
+	this->bestScore = 0.0f;
+	this->topWindows.clear();
+	// score map belongs only to the last dense crop
+	this->scoreMap.release();
+}
+
+/*
+* Setter function for number of returned crops (pool of the best ROIs is kept only if k > 1, one ROI per region of image)
+*/
+void AutocropStentiford::setTopK(int k) {
+	this->topK = std::max(1, k);
+	// pool keeps only the best window of each region, so it is not filled with small shifts of the best window
+	this->topWindows = TopKWindows((this->topK > 1) ? this->topK * TOPK_POOL_FACTOR : 0,
+		std::max(1, this->salMap.cols / TOPK_REGIONS), std::max(1, this->salMap.rows / TOPK_REGIONS));
+}
+
+/*
+* Getter function for the best distinct crops (the first one is final crop, IoU of any two crops is at most TOPK_MAX_IOU)
+*/
+std::vector<cv::Rect> AutocropStentiford::getTopCandidates() {
+	std::vector<ScoredWindow> first(1, ScoredWindow(this->bestScore, this->x, this->y, this->width, this->height));
+	std::vector<ScoredWindow> windows = this->topWindows.suppress(this->topK, first);
+
+	std::vector<cv::Rect> rois;
+	for (size_t i = 0; i < windows.size(); i++)
+		rois.push_back(cv::Rect(windows[i].x, windows[i].y, windows[i].width, windows[i].height));
+	return rois;
+}
+
+/*
+* Getter function for map of saliency energy of all positions computed by the last dense method (empty if it was not used)
+*/
+cv::Mat AutocropStentiford::getScoreMap() {
+	return this->scoreMap;
 }
\ No newline at end of file
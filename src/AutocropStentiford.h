@@ -10,7 +10,17 @@
 #ifndef __AUTOCROPSTENTIFORD_H__
 #define __AUTOCROPSTENTIFORD_H__
 
+#include <queue>
 #include <opencv2/opencv.hpp>
+#include "SaliencyIntegral.h"
+#include "ParallelReduction.h"
+#include "PyramidSearch.h"
+#include "RandomGenerator.h"
+#include "TopKWindows.h"
+#include "DenseScoreMap.h"
+#include "SaliencySampler.h"
+#include "CandidateBatch.h"
+#include "SaliencyScorer.h"
 
 using namespace std;
 using namespace cv;
@@ -32,6 +42,13 @@ public:
 	void randomWHratio(int w, int h, float maxZoomFactor);
 	void randomZFWalk(float maxZoomFactor);
 	void randomWalk(int minWidth, int minHeight);
+	void importanceZFWalk(float maxZoomFactor, int samples = ITERATIONS);
+	void importanceWHratio(int w, int h, float maxZoomFactor, int samples = ITERATIONS);
+	void branchAndBoundZF(float maxZoomFactor);
+	void pyramidWH(int w, int h, int hStep = DEFAULT_STEP_STENTIFORD, int vStep = DEFAULT_STEP_STENTIFORD);
+	void pyramidZoomFactor(float zFactor, int hStep = DEFAULT_STEP_STENTIFORD, int vStep = DEFAULT_STEP_STENTIFORD);
+	void denseWH(int w, int h);
+	void denseZoomFactor(float zFactor);
 	// method for computing the best average pixel attention score
 	void computeMaxScore(int x1, int y1, int w, int h);
 
@@ -40,6 +57,11 @@ public:
 	int getY();
 	int getWidth();
 	int getHeight();
+	void setSeed(uint64_t seed);
+	void reset();
+	void setTopK(int k);
+	std::vector<cv::Rect> getTopCandidates();
+	cv::Mat getScoreMap();
 
 private:
 	// ROI parameters 
@@ -49,8 +71,23 @@ private:
 	int height;
 	// value of actual best score of ROI with highest attention measure
 	double bestScore;
+	// method for saving ROI if its score is better than actual best score
+	void saveIfBetter(const ScoredWindow& roi);
+	// method for scoring batch of ROIs and saving the best one
+	void selectBest(CandidateBatch& candidates);
+	// method for computing average attention score of ROI (invalid window if ROI is out of saliency map)
+	ScoredWindow scoreWindow(int x1, int y1, int w, int h);
+	// seed for random generators
+	uint64_t seed;
+	// number of returned crops and pool of the best ROIs found by all methods
+	int topK;
+	TopKWindows topWindows;
 	// saliency map from original image
 	cv::Mat salMap;
+	// map of saliency energy of all positions (dense methods)
+	cv::Mat scoreMap;
+	// summed-area table of saliency map (computed only once)
+	SaliencyIntegral integral;
 };
 
 #endif //__AUTOCROPSTENTIFORD_H__
\ No newline at end of file
@@ -19,8 +19,17 @@ AutocropSuh::AutocropSuh(cv::Mat sm) {
 	this->width = sm.cols;
 	this->height = sm.rows;
 	this->salmap = sm;
+	// summed-area table is computed only once, every ROI is then evaluated in O(1)
+	this->integral.compute(sm);
 	// compute saliency value of original image ROI
-	this->totalSaliency = this->computeSaliency(0, 0, this->width, this->height); // sum(this->salmap)[0];
+	this->totalSaliency = this->integral.total(); // sum(this->salmap)[0];
+	// random generators are initialized with actual time, if seed is not defined
+	this->seed = RandomGenerator::timeSeed();
+	// only the best ROI is searched by default
+	this->topK = 1;
+	// frontier is not computed yet
+	this->frontierHStep = 0;
+	this->frontierVStep = 0;
 }
 
 
@@ -40,25 +49,13 @@ void AutocropSuh::bruteForceWH(int w, int h, int hStep, int vStep) {
 	this->width = w;
 	this->height = h;
 
-	// values for end of loop
-	int endColumn = this->salmap.cols - w;
-	int endRow = this->salmap.rows - h;
-
-	// tmp variable for finding best ratio
-	double bestRatio = 0.0f;
+	// select the best ratio as final crop ROI
+	ScoredWindow best = this->bestWindowWH(w, h, hStep, vStep, this->topWindows);
 
-#pragma omp parallel for
-	for (int xx = 0; xx < endColumn; xx += hStep) {
-		for (int yy = 0; yy < endRow; yy += vStep) {
-			uint32_t salValue = this->computeSaliency(xx, yy, w, h);
-			double ratio = (double)salValue / (double)this->totalSaliency;
-			// select the best ratio as final crop ROI
-			if (ratio > bestRatio) {
-				bestRatio = ratio;
-				this->x = xx;
-				this->y = yy;
-			}
-		}
+	// save position of the best ROI
+	if (best.isValid() && best.score > 0.0) {
+		this->x = best.x;
+		this->y = best.y;
 	}
 }
 
@@ -78,34 +75,122 @@ void AutocropSuh::bruteForceScale(float scale, int hStep, int vStep) {
 	this->width = (int)(scale * this->salmap.cols);
 	this->height = (int)(scale * this->salmap.rows);
 
-	// values for end of loop
-	int endColumn = this->salmap.cols - this->width;
-	int endRow = this->salmap.rows - this->height;
+	// select best ratio as final crop ROI
+	ScoredWindow best = this->bestWindowWH(this->width, this->height, hStep, vStep, this->topWindows);
 
-	// tmp variable for finding best ratio
-	double bestRatio = 0.0f;
+	// save position of the best ROI
+	if (best.isValid() && best.score > 0.0) {
+		this->x = best.x;
+		this->y = best.y;
+	}
+}
 
-#pragma omp parallel for
-	for (int xx = 0; xx < endColumn; xx += hStep) {
-		for (int yy = 0; yy < endRow; yy += vStep) {
-			uint32_t salValue = this->computeSaliency(xx, yy, this->width, this->height);
-			double ratio = (double)salValue / (double)this->totalSaliency;
-			// select best ratio as final crop ROI
-			if (ratio > bestRatio) {
-				bestRatio = ratio;
-				this->x = xx;
-				this->y = yy;
-			}
-		}
+
+/**
+ * Method for finding ROI with defined width and height using coarse-to-fine search
+ * (grid with hStep and vStep is walked through only at the coarsest level, final position is found with 1px precision)
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @param hStep Horizontal step at the coarsest level
+ * @param vStep Vertical step at the coarsest level
+ */
+void AutocropSuh::pyramidWH(int w, int h, int hStep, int vStep) {
+	// input conditions
+	if (this->salmap.cols < w || this->salmap.rows < h || w < 1 || h < 1 || hStep < 1 || vStep < 1)
+		return;
+
+	// save width and height of ROI
+	this->width = w;
+	this->height = h;
+
+	PyramidSearch search(this->integral);
+	std::vector<ScoredWindow> best = search.searchWH(w, h, hStep, vStep, std::max(PYRAMID_TOP_K, this->topWindows.getCapacity()));
+
+	// saliency energy of window => ratio of saliency energy ROI/original image
+	for (size_t i = 0; i < best.size(); i++) {
+		best[i].score /= (double)this->totalSaliency;
+		this->topWindows.push(best[i]);
+	}
+
+	// save position of the best ROI
+	if (!best.empty() && best.front().score > 0.0) {
+		this->x = best.front().x;
+		this->y = best.front().y;
+	}
+}
+
+
+/**
+ * Method for finding ROI with defined scale factor using coarse-to-fine search
+ * @param scale Scale factor = ratio how the crop should be scaled down against original image
+ * @param hStep Horizontal step at the coarsest level
+ * @param vStep Vertical step at the coarsest level
+ */
+void AutocropSuh::pyramidScale(float scale, int hStep, int vStep) {
+	// input conditions
+	if (scale <= 0.0f || scale >= 1.0f || hStep < 1 || vStep < 1)
+		return;
+
+	this->pyramidWH((int)(scale * this->salmap.cols), (int)(scale * this->salmap.rows), hStep, vStep);
+}
+
+
+/**
+ * Method for finding ROI with defined width and height at every position (stride 1px) using dense map of saliency energy
+ * @param w Width of ROI
+ * @param h Height of ROI
+ */
+void AutocropSuh::denseWH(int w, int h) {
+	// input conditions
+	if (this->salmap.cols < w || this->salmap.rows < h || w < 1 || h < 1)
+		return;
+
+	// save width and height of ROI
+	this->width = w;
+	this->height = h;
+
+	// saliency energy of all positions computed by running sums
+	DenseScoreMap dense(this->salmap);
+	this->scoreMap = dense.computeWH(w, h);
+	TopKWindows pool = this->topWindows.emptyCopy();
+	ScoredWindow best = DenseScoreMap::bestWindow(this->scoreMap, w, h, pool);
+
+	// saliency energy of window => ratio of saliency energy ROI/original image
+	std::vector<ScoredWindow> windows = pool.sorted();
+	for (size_t i = 0; i < windows.size(); i++) {
+		windows[i].score /= (double)this->totalSaliency;
+		this->topWindows.push(windows[i]);
+	}
+
+	// save position of the best ROI
+	if (best.isValid() && best.score > 0.0) {
+		this->x = best.x;
+		this->y = best.y;
 	}
 }
 
 
+/**
+ * Method for finding ROI with defined scale factor at every position (stride 1px)
+ * @param scale Scale factor = ratio how the crop should be scaled down against original image
+ */
+void AutocropSuh::denseScale(float scale) {
+	// input conditions
+	if (scale <= 0.0f || scale >= 1.0f)
+		return;
+
+	this->denseWH((int)(scale * this->salmap.cols), (int)(scale * this->salmap.rows));
+}
+
+
 /**
  * Method for finding ROI with defined aspect ratio(width:height)
+ * The smallest size of ROI that satisfies treshold is found by binary search over size of ROI, each size is walked through in parallel.
+ * Saliency energy of the best ROI grows with its size: grid of bestWindowWH includes flush positions at right and bottom border,
+ * so every ROI of smaller size is inside of some ROI of larger size. The size below result is checked after convergence.
  * @param w Horizontal parameter for computing width:height ratio
  * @param h Vertical parameter for computing width:height ratio
- * @param treshold 
+ * @param treshold Minimal ratio of saliency energy in ROI
  * @param hStep Horizontal step - number of pixels in x-axis
  * @param vStep Vertical step - number of pixels in y-axis
  */
@@ -114,60 +199,71 @@ void AutocropSuh::bruteForceWHratio(int w, int h, float treshold, int hStep, int
 	if (w < 1 || h < 1 || treshold <= 0.0f || treshold >= 1.0f || hStep < 1 || vStep < 1)
 		return;
 
-	// constant for incrementing width or height until ROI with satisfied treshold is found
-	const int SIZE_INCREMENT = (w > h) ? (int)(0.1f * this->salmap.cols) : (int)(0.1f * this->salmap.rows);
-
-	// init temporary variables for width and height
-	int tmpW, tmpH;
-	if (w > h) {
-		tmpW = (int)(MAX_SCALE_SUH * this->salmap.cols);
-		tmpH = (int)(tmpW * h / w);
-	}
-	else {
-		tmpH = (int)(MAX_SCALE_SUH * this->salmap.rows);
-		tmpW = (int)(tmpH * w / h);
-	}
-
-	// init temporary variable for bestRatio value
-	float bestRatio = 0.0f;
-
-	// loop until reaching size limits
-	while ((tmpW < this->salmap.cols) && (tmpH < this->salmap.rows)) {
-		// values for end of loop
-		int endColumn = this->salmap.cols - tmpW;
-		int endRow = this->salmap.rows - tmpH;
-		
-		for (int xx = 0; xx < endColumn; xx += hStep) {
-			for (int yy = 0; yy < endRow; yy += vStep) {
-				uint32_t salValue = this->computeSaliency(xx, yy, tmpW, tmpH);
-				double ratio = (double)salValue / (double)this->totalSaliency;
-
-				// check if ROI with defined treshold value was found
-				if (ratio > treshold && ratio > bestRatio) {
-					bestRatio = ratio;
-					this->x = xx;
-					this->y = yy;
-					this->width = tmpW;
-					this->height = tmpH;
-				}
-			}
-		}
-
-		// result ROI was found
-		if (bestRatio > 0.0f)
-			return;
-
-		// increment size of ROI
-		if (w > h) {
-			tmpW += SIZE_INCREMENT;
-			tmpH = (int)(tmpW * h / w);
+	// size of ROI is defined by its width (w > h) or by its height, the other side is computed from aspect ratio
+	const bool byWidth = (w > h);
+	const int cols = this->salmap.cols;
+	const int rows = this->salmap.rows;
+
+	// minimal size of ROI
+	int minSize = byWidth ? (int)(MAX_SCALE_SUH * cols) : (int)(MAX_SCALE_SUH * rows);
+	if (minSize < 1) minSize = 1;
+	// maximal size of ROI => both sides must be smaller than saliency map (the same limit as before)
+	int maxSize = byWidth ? (int)std::min((long long)cols - 1, ((long long)rows * w - 1) / h)
+		: (int)std::min((long long)rows - 1, ((long long)cols * h - 1) / w);
+
+	// binary search for the smallest size with satisfied treshold
+	ScoredWindow result;
+	TopKWindows resultPool;
+	int low = minSize;
+	int high = maxSize;
+	while (low <= high) {
+		int size = low + (high - low) / 2;
+		int tmpW = byWidth ? size : (int)(size * w / h);
+		int tmpH = byWidth ? (int)(size * h / w) : size;
+
+		// the best ROI of actual size
+		TopKWindows pool = this->topWindows.emptyCopy();
+		ScoredWindow best = this->bestWindowWH(tmpW, tmpH, hStep, vStep, pool);
+
+		// check if ROI with defined treshold value was found
+		if (best.isValid() && best.score > treshold) {
+			result = best;
+			resultPool = pool;
+			high = size - 1;
 		}
 		else {
-			tmpH += SIZE_INCREMENT;
-			tmpW = (int)(tmpH * w / h);
+			low = size + 1;
 		}
 	}
 
+	// the size below result must not satisfy treshold (result is the smallest size)
+	int resultSize = byWidth ? result.width : result.height;
+	while (result.isValid() && resultSize > minSize) {
+		int size = resultSize - 1;
+		int tmpW = byWidth ? size : (int)(size * w / h);
+		int tmpH = byWidth ? (int)(size * h / w) : size;
+
+		TopKWindows pool = this->topWindows.emptyCopy();
+		ScoredWindow best = this->bestWindowWH(tmpW, tmpH, hStep, vStep, pool);
+		if (!best.isValid() || best.score <= treshold)
+			break;
+
+		result = best;
+		resultPool = pool;
+		resultSize = size;
+	}
+
+	// result ROI was found
+	if (result.isValid()) {
+		this->x = result.x;
+		this->y = result.y;
+		this->width = result.width;
+		this->height = result.height;
+		// other crops have the same size as result ROI
+		this->topWindows.merge(resultPool);
+		return;
+	}
+
 	std::cerr << "ROI with ratio(width:height) = " << w << ":" << h << " was not found. Try to reduce treshold." << std::endl;
 }
 
@@ -182,7 +278,7 @@ void AutocropSuh::greedyGeneral(float treshold) {
 		return;
 
 	// init treshold sum
-	int tresholdSum = (int)(treshold * this->totalSaliency);
+	uint64_t tresholdSum = (uint64_t)(treshold * this->totalSaliency);
 
 	// constant for recrangle size around peak points
 	int RECTANGLE_SIZE = (int)(this->salmap.cols / 20); 
@@ -205,24 +301,19 @@ void AutocropSuh::greedyGeneral(float treshold) {
 	if (tmpY2 >= this->salmap.rows) tmpY2 = this->salmap.rows - 1;
 	
 	// init temporary saliency sum value
-	int currentSaliencySum = this->computeSaliency(tmpX1, tmpY1, (tmpX2 - tmpX1), (tmpY2 - tmpY1));
-	// deep copy of original saliency map
-	cv::Mat editedSalmap = this->salmap.clone();
+	uint64_t currentSaliencySum = this->computeSaliency(tmpX1, tmpY1, (tmpX2 - tmpX1), (tmpY2 - tmpY1));
+	// sorted pixels of saliency map - replaces writing zeros to actual Rc in copy of saliency map
+	// and searching for maximum in whole map in each iteration
+	SaliencyPeakIndex peaks(this->salmap);
 
 	// loop until reaching threshold sum
 	while (currentSaliencySum < tresholdSum) {
-		// write minimum values to actual Rc
-		for (int i = tmpX1; i <= tmpX2; i++) {
-			for (int j = tmpY1; j <= tmpY2; j++) {
-				// write minimum value <=> 0(black)
-				editedSalmap.data[j * this->salmap.cols + i] = 0;
-			}
-		}
-		
-		// find maximum saliency point
-		double min, max;
-		cv::Point min_loc, max_loc;
-		cv::minMaxLoc(editedSalmap, &min, &max, &min_loc, &max_loc);
+		// find maximum saliency point outside of actual Rc
+		cv::Point max_loc;
+		int max = peaks.nextPeakOutside(tmpX1, tmpY1, tmpX2, tmpY2, max_loc);
+		// there is no more saliency energy outside of actual Rc
+		if (max <= 0)
+			break;
 
 		// check if maximum saliency point is horizontally left or right from actual RC
 		if (tmpX1 > max_loc.x) 
@@ -274,58 +365,380 @@ void AutocropSuh::bruteForceGeneral(float treshold) {
 	int endColumn = this->salmap.cols - minWidth;
 	int endRow = this->salmap.rows - minHeight;
 
-	// vector for saving candidates for cropping
-	std::vector<std::array<int, 4>> candidates;
-
-	// temporary variables
-	int tmpWidth, tmpHeight;
-
-	// initialize random number generator
-	srand((unsigned int)time(NULL));
-
 	// number of ROIs that will be generated at each position in grid
 	const int ROI_NUMBER = 3;
 
+	// candidate ROI with the smallest area (score = -area) is reduced from private results of each thread
+	ScoredWindow best;
+
 	// loop through grid
-	for (int xx = 0; xx < endColumn; xx += hStep) {
-		for (int yy = 0; yy < endRow; yy += vStep) {
+#pragma omp parallel for reduction(bestWindow : best)
+	for (int yy = 0; yy < endRow; yy += vStep) {
+		for (int xx = 0; xx < endColumn; xx += hStep) {
+			// each position in grid has its own random sequence
+			RandomGenerator rng(this->seed, RANDOM_DOMAIN_SUH_GENERAL, (uint64_t)yy * this->salmap.cols + xx);
+
 			for (int j = 0; j < ROI_NUMBER; j++) { // generate 3 ROIs at each location in grid
-				tmpWidth = rand() % (this->salmap.cols - xx);
+				int tmpWidth = rng.uniform(this->salmap.cols - xx);
 				tmpWidth = (tmpWidth >= minWidth) ? tmpWidth : minWidth;
-				tmpHeight = rand() % (this->salmap.rows - yy);
+				int tmpHeight = rng.uniform(this->salmap.rows - yy);
 				tmpHeight = (tmpHeight >= minHeight) ? tmpHeight : minHeight;
 
-				uint32_t salValue = this->computeSaliency(xx, yy, tmpWidth, tmpHeight);
+				uint64_t salValue = this->computeSaliency(xx, yy, tmpWidth, tmpHeight);
 				float ratio = (float)((double)salValue / this->totalSaliency);
 
-				// save all ROIs with satisfying treshold
-				if (ratio >= treshold) {
-					std::array<int, 4> roi = { xx, yy, tmpWidth, tmpHeight };
-					candidates.push_back(roi);
+				// candidate ROIs with satisfying treshold
+				if (ratio >= treshold)
+					best.update(ScoredWindow(-(double)tmpWidth * tmpHeight, xx, yy, tmpWidth, tmpHeight));
+			}
+		}
+	}
+
+	// save ROI coordinates
+	if (best.isValid()) {
+		this->x = best.x;
+		this->y = best.y;
+		this->width = best.width;
+		this->height = best.height;
+	}
+}
+
+
+/**
+ * General method for finding ROI with the smallest area whose saliency energy is at least treshold of total energy.
+ * ROIs are walked through by minimalWindows: at first in grid (hStep, vStep), then area of the best ROI in grid is used
+ * as upper bound for walking through all ROIs with 1 pixel precision, where most of widths and columns are skipped.
+ * Result is always the smallest ROI in pixels (exact), grid only makes the bound tight before the exact pass.
+ * @param treshold Value of treshold for minimum saliency energy
+ * @param hStep Horizontal step - number of pixels in x-axis (grid of the first pass)
+ * @param vStep Vertical step - number of pixels in y-axis (grid of the first pass)
+ */
+void AutocropSuh::exactGeneral(float treshold, int hStep, int vStep) {
+	// input conditions
+	if (treshold <= 0.f || treshold >= 1.0f || hStep < 1 || vStep < 1)
+		return;
+
+	const int cols = this->salmap.cols;
+	const int rows = this->salmap.rows;
+
+	// apply max scale constant to get minimal width and height of ROI (the same limits as in bruteForceGeneral)
+	int minWidth = (int)(MAX_SCALE_SUH * cols);
+	int minHeight = (int)(MAX_SCALE_SUH * rows);
+	if (minWidth < 1) minWidth = 1;
+	if (minHeight < 1) minHeight = 1;
+	if (minWidth > cols || minHeight > rows)
+		return;
+
+	// minimal saliency energy of ROI
+	const uint64_t tresholdSum = (uint64_t)std::ceil((double)treshold * (double)this->totalSaliency);
+
+	TopKWindows pool = this->topWindows.emptyCopy();
+	// the whole image is the largest possible ROI
+	ScoredWindow best = this->minimalWindows(tresholdSum, minWidth, minHeight, hStep, vStep, (double)cols * rows, pool);
+	// exact pass is bounded by area of the best ROI in grid
+	if (best.isValid() && (hStep > 1 || vStep > 1))
+		best.update(this->minimalWindows(tresholdSum, minWidth, minHeight, 1, 1, -best.score, pool));
+
+	// save ROI coordinates
+	if (best.isValid()) {
+		this->x = best.x;
+		this->y = best.y;
+		this->width = best.width;
+		this->height = best.height;
+	}
+	this->topWindows.merge(pool);
+}
+
+
+/**
+ * Method for finding ROI with the smallest area whose saliency energy is at least tresholdSum (walking through grid in parallel).
+ * Left side and width of ROI are taken from grid (hStep), for each such pair of columns the minimal height is found
+ * for every top side in grid (vStep) by two-pointer sweep: when top side moves down, the bottom side can only move down
+ * (saliency is non-negative), so whole sweep is O(rows) lookups in summed-area table. Widths are walked through in parallel.
+ * ROIs larger than maxArea are not searched: widths whose lowest ROI is larger are skipped and so are pairs of columns
+ * that do not have enough saliency energy even in full height.
+ * @param tresholdSum Minimal saliency energy of ROI
+ * @param minWidth Minimal width of ROI
+ * @param minHeight Minimal height of ROI
+ * @param hStep Horizontal step - number of pixels in x-axis (left side and width of ROI)
+ * @param vStep Vertical step - number of pixels in y-axis (top side of ROI)
+ * @param maxArea Upper bound of area of ROI
+ * @param topPool Pool where the best ROIs are saved (score = -area)
+ * @return ROI with the smallest area (score = -area, invalid window if there is no such ROI)
+ */
+ScoredWindow AutocropSuh::minimalWindows(uint64_t tresholdSum, int minWidth, int minHeight, int hStep, int vStep, double maxArea, TopKWindows& topPool) {
+	const int cols = this->salmap.cols;
+	const int rows = this->salmap.rows;
+	// number of widths in grid
+	const int widthCount = (cols - minWidth) / hStep + 1;
+
+	// ROI with the smallest area (score = -area) is reduced from private results of each thread
+	ScoredWindow best;
+	TopKWindows pool = topPool.emptyCopy();
+
+#pragma omp parallel for schedule(dynamic) reduction(bestWindow : best) reduction(topWindows : pool)
+	for (int i = 0; i < widthCount; i++) {
+		const int w = minWidth + i * hStep;
+		// even the lowest ROI of this width is larger than bound or than the best ROI found by this thread
+		if ((double)w * minHeight > maxArea)
+			continue;
+		if (-(double)w * minHeight < best.score && pool.getCapacity() == 0)
+			continue;
+		// the highest ROI of this width within bound
+		const int maxHeight = (int)std::min((double)rows, std::floor(maxArea / w));
+
+		for (int xx = 0; xx + w <= cols; xx += hStep) {
+			// there is not enough saliency energy between these columns
+			if (this->integral.sum(xx, 0, w, rows) < tresholdSum)
+				continue;
+
+			// bottom side of ROI (exclusive)
+			int y2 = minHeight;
+
+			for (int yy = 0; yy + minHeight <= rows; yy += vStep) {
+				if (y2 < yy + minHeight)
+					y2 = yy + minHeight;
+				// move bottom side down until ROI satisfies treshold (or until it is higher than bound)
+				while (y2 <= rows && y2 - yy <= maxHeight && this->integral.sum(xx, yy, w, y2 - yy) < tresholdSum)
+					y2++;
+				// there is not enough saliency energy below actual top side
+				if (y2 > rows)
+					break;
+				// the smallest ROI with this top side is larger than bound
+				if (y2 - yy > maxHeight)
+					continue;
+
+				ScoredWindow roi(-(double)w * (y2 - yy), xx, yy, w, y2 - yy);
+				best.update(roi);
+				pool.push(roi);
+			}
+		}
+	}
+
+	topPool.merge(pool);
+	return best;
+}
+
+
+/**
+ * Method for computing frontier of saliency energy vs. area in one pass through all ROIs in grid.
+ * Areas of ROIs are divided into buckets (bucket b contains ROIs with area in (b/buckets, (b+1)/buckets] of image area)
+ * and for each bucket the ROI with the highest ratio of saliency energy and area at most upper bound of bucket is saved.
+ * Any treshold or area budget is then answered by lookup (frontierByThreshold, frontierByArea).
+ * @param hStep Horizontal step - number of pixels in x-axis (left side and width of ROI)
+ * @param vStep Vertical step - number of pixels in y-axis (top side and height of ROI)
+ * @param buckets Number of area buckets
+ */
+void AutocropSuh::computeFrontier(int hStep, int vStep, int buckets) {
+	// input conditions
+	if (hStep < 1 || vStep < 1 || buckets < 1)
+		return;
+
+	const int cols = this->salmap.cols;
+	const int rows = this->salmap.rows;
+	const double imageArea = (double)cols * (double)rows;
+	// widths and heights in grid from the size of image (whole image is included)
+	const int widthCount = (cols - 1) / hStep + 1;
+	const int heightCount = (rows - 1) / vStep + 1;
+
+	this->frontier.assign(buckets, ScoredWindow());
+	this->frontierHStep = hStep;
+	this->frontierVStep = vStep;
+
+#pragma omp parallel
+	{
+		// each thread has its own frontier, frontiers are merged at the end
+		std::vector<ScoredWindow> local(buckets);
+
+#pragma omp for schedule(dynamic)
+		for (int i = 0; i < widthCount; i++) {
+			const int w = cols - i * hStep;
+			for (int j = 0; j < heightCount; j++) {
+				const int h = rows - j * vStep;
+				// bucket of actual area
+				int b = (int)std::ceil((double)w * (double)h / imageArea * buckets) - 1;
+				b = std::min(std::max(b, 0), buckets - 1);
+
+				for (int yy = 0; yy + h <= rows; yy += vStep) {
+					for (int xx = 0; xx + w <= cols; xx += hStep) {
+						double ratio = (double)this->computeSaliency(xx, yy, w, h) / (double)this->totalSaliency;
+						local[b].update(ScoredWindow(ratio, xx, yy, w, h));
+					}
 				}
 			}
 		}
+
+#pragma omp critical
+		for (int b = 0; b < buckets; b++)
+			this->frontier[b].update(local[b]);
 	}
 
+	// ROI from smaller bucket can be used also for larger area => frontier is non-decreasing
+	for (int b = 1; b < buckets; b++)
+		this->frontier[b].update(this->frontier[b - 1]);
+}
+
 
-	int bestIndex = 0;
-	int smallestArea = INT_MAX;
-	// find candidate ROI with smallest area
-	for (int i = 0; i < candidates.size(); i++) {
-		int Sarea = std::get<2>(candidates.at(i)) * std::get<3>(candidates.at(i));
-		if (Sarea < smallestArea) {
-			smallestArea = Sarea;
-			bestIndex = i;
+/**
+ * Method for selecting ROI with the smallest area bucket that satisfies treshold (lookup in computed frontier)
+ * @param treshold Value of treshold for minimum saliency energy
+ * @return True if such ROI exists in frontier, else False
+ */
+bool AutocropSuh::frontierByThreshold(float treshold) {
+	for (size_t b = 0; b < this->frontier.size(); b++) {
+		if (this->frontier[b].isValid() && this->frontier[b].score >= treshold) {
+			this->x = this->frontier[b].x;
+			this->y = this->frontier[b].y;
+			this->width = this->frontier[b].width;
+			this->height = this->frontier[b].height;
+			return true;
 		}
 	}
 
-	// save ROI coordinates
-	if (candidates.size() > 0) {
-		this->x = std::get<0>(candidates.at(bestIndex));
-		this->y = std::get<1>(candidates.at(bestIndex));
-		this->width = std::get<2>(candidates.at(bestIndex));
-		this->height = std::get<3>(candidates.at(bestIndex));
+	return false;
+}
+
+
+/**
+ * Method for selecting ROI with the highest saliency energy within area budget (lookup in computed frontier)
+ * @param maxArea Maximal area of ROI as ratio of image area in range (0,1]
+ * @return True if such ROI exists in frontier, else False
+ */
+bool AutocropSuh::frontierByArea(float maxArea) {
+	if (this->frontier.empty() || maxArea <= 0.0f)
+		return false;
+
+	// the last bucket whose upper bound is not larger than area budget
+	int b = (int)std::floor((double)maxArea * this->frontier.size() + 1e-9) - 1;
+	b = std::min(b, (int)this->frontier.size() - 1);
+	if (b < 0 || !this->frontier[b].isValid())
+		return false;
+
+	this->x = this->frontier[b].x;
+	this->y = this->frontier[b].y;
+	this->width = this->frontier[b].width;
+	this->height = this->frontier[b].height;
+	return true;
+}
+
+
+/**
+ * Method for saving computed frontier to file storage(format .yml)
+ * (steps of grid, number of buckets and fingerprint of saliency map are saved too, so stale file is recognized by loadFrontier)
+ * @param filepath Path of .yml file
+ */
+void AutocropSuh::saveFrontier(std::string filepath) {
+	// one row for each bucket: ratio, x, y, width, height
+	cv::Mat frontierMat((int)this->frontier.size(), 5, CV_64F);
+	for (int b = 0; b < frontierMat.rows; b++) {
+		frontierMat.at<double>(b, 0) = this->frontier[b].isValid() ? this->frontier[b].score : -1.0;
+		frontierMat.at<double>(b, 1) = this->frontier[b].x;
+		frontierMat.at<double>(b, 2) = this->frontier[b].y;
+		frontierMat.at<double>(b, 3) = this->frontier[b].width;
+		frontierMat.at<double>(b, 4) = this->frontier[b].height;
+	}
+
+	FileStorage fs = FileStorage(filepath, FileStorage::WRITE | FileStorage::FORMAT_YAML);
+	if (!fs.isOpened()) {
+		std::cerr << "Cannot save frontier to file " << filepath << std::endl;
+		return;
 	}
+	cv::write(fs, "cols", this->salmap.cols);
+	cv::write(fs, "rows", this->salmap.rows);
+	cv::write(fs, "hStep", this->frontierHStep);
+	cv::write(fs, "vStep", this->frontierVStep);
+	cv::write(fs, "buckets", frontierMat.rows);
+	cv::write(fs, "fingerprint", this->salmapFingerprint());
+	cv::write(fs, "frontier", frontierMat);
+}
+
+
+/**
+ * Method for loading frontier saved by saveFrontier
+ * @param filepath Path of .yml file
+ * @param hStep Horizontal step of grid the frontier must be computed with
+ * @param vStep Vertical step of grid the frontier must be computed with
+ * @param buckets Number of area buckets the frontier must have
+ * @return True if frontier was loaded and belongs to the same saliency map, grid and buckets, else False (frontier has to be computed)
+ */
+bool AutocropSuh::loadFrontier(std::string filepath, int hStep, int vStep, int buckets) {
+	cv::FileStorage fs = FileStorage(filepath, FileStorage::READ | FileStorage::FORMAT_YAML);
+	if (!fs.isOpened())
+		return false;
+
+	int cols = 0, rows = 0, fileHStep = 0, fileVStep = 0, fileBuckets = 0;
+	std::string fingerprint;
+	cv::Mat frontierMat;
+	fs["cols"] >> cols;
+	fs["rows"] >> rows;
+	fs["hStep"] >> fileHStep;
+	fs["vStep"] >> fileVStep;
+	fs["buckets"] >> fileBuckets;
+	fs["fingerprint"] >> fingerprint;
+	fs["frontier"] >> frontierMat;
+
+	// conditions for loaded data (the same saliency map, grid and buckets)
+	if (cols != this->salmap.cols || rows != this->salmap.rows || fileHStep != hStep || fileVStep != vStep)
+		return false;
+	if (fileBuckets != buckets || frontierMat.rows != buckets || frontierMat.cols != 5 || frontierMat.type() != CV_64F)
+		return false;
+	if (fingerprint != this->salmapFingerprint())
+		return false;
+
+	this->frontier.assign(frontierMat.rows, ScoredWindow());
+	this->frontierHStep = hStep;
+	this->frontierVStep = vStep;
+	for (int b = 0; b < frontierMat.rows; b++) {
+		if (frontierMat.at<double>(b, 0) < 0.0)
+			continue;
+		this->frontier[b] = ScoredWindow(frontierMat.at<double>(b, 0), (int)frontierMat.at<double>(b, 1), (int)frontierMat.at<double>(b, 2),
+			(int)frontierMat.at<double>(b, 3), (int)frontierMat.at<double>(b, 4));
+	}
+
+	return true;
+}
+
+
+/**
+ * Method for finding ROI with the highest ratio of saliency energy for defined width and height (walking through grid in parallel).
+ * Grid includes also flush positions at right and bottom border of saliency map (ROI touching the border).
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @param hStep Horizontal step - number of pixels in x-axis
+ * @param vStep Vertical step - number of pixels in y-axis
+ * @param topPool Pool where the best ROIs are saved (for more returned crops)
+ * @return The best ROI, its score is ratio of saliency energy ROI/original image
+ */
+ScoredWindow AutocropSuh::bestWindowWH(int w, int h, int hStep, int vStep, TopKWindows& topPool) {
+	// last positions of top left corner
+	int endColumn = this->salmap.cols - w;
+	int endRow = this->salmap.rows - h;
+	if (endColumn < 0 || endRow < 0)
+		return ScoredWindow();
+
+	// number of positions of grid in each axis (the last one is flush with border)
+	const int gridCols = (endColumn + hStep - 1) / hStep + 1;
+	const int gridRows = (endRow + vStep - 1) / vStep + 1;
+
+	// best ROI is reduced from private results of each thread
+	ScoredWindow best;
+	TopKWindows pool = topPool.emptyCopy();
+
+#pragma omp parallel for reduction(bestWindow : best) reduction(topWindows : pool)
+	for (int j = 0; j < gridRows; j++) {
+		int yy = std::min(j * vStep, endRow);
+		for (int i = 0; i < gridCols; i++) {
+			int xx = std::min(i * hStep, endColumn);
+			uint64_t salValue = this->computeSaliency(xx, yy, w, h);
+			double ratio = (double)salValue / (double)this->totalSaliency;
+			ScoredWindow roi(ratio, xx, yy, w, h);
+			best.update(roi);
+			pool.push(roi);
+		}
+	}
+
+	topPool.merge(pool);
+	return best;
 }
 
 
@@ -337,26 +750,42 @@ void AutocropSuh::bruteForceGeneral(float treshold) {
  * @param h Height of ROI
  * @return Saliency energy of defined ROI
  */
-uint32_t AutocropSuh::computeSaliency(int x1, int y1, int w, int h) {
+uint64_t AutocropSuh::computeSaliency(int x1, int y1, int w, int h) {
 	// position of bottom right corner
 	int x2 = x1 + w;
 	int y2 = y1 + h;
 	
 	// input conditions -> return 0 ratio
+	if (x1 < 0 || y1 < 0)
+		return 0;
 	if (this->salmap.cols < x2)
 		return 0;
 	if (this->salmap.rows < y2)
 		return 0;
 
-	uint32_t saliency = 0;
-	for (int i = x1; i < x2; i++) {
-		for (int j = y1; j < y2; j++) {
-			// increment score with pixel value [0,255]
-			saliency += this->salmap.data[j * this->salmap.cols + i];
+	// O(1) lookup in summed-area table instead of walking through all pixels of ROI
+	return this->integral.sum(x1, y1, w, h);
+}
+
+
+/**
+ * Method for computing fingerprint of saliency map (64-bit FNV-1a hash of its values)
+ * @return Hexadecimal string of hash (YAML integers have only 32 bits)
+ */
+std::string AutocropSuh::salmapFingerprint() {
+	uint64_t hash = 14695981039346656037ULL;
+	const size_t rowBytes = this->salmap.cols * this->salmap.elemSize();
+	for (int r = 0; r < this->salmap.rows; r++) {
+		const uchar* row = this->salmap.ptr<uchar>(r);
+		for (size_t i = 0; i < rowBytes; i++) {
+			hash ^= row[i];
+			hash *= 1099511628211ULL;
 		}
 	}
 
-	return saliency;
+	std::ostringstream stream;
+	stream << std::hex << hash;
+	return stream.str();
 }
 
 
@@ -386,4 +815,54 @@ int AutocropSuh::getWidth() {
 */
 int AutocropSuh::getHeight() {
 	return this->height;
+}
+
+/*
+* Setter function for seed of random generators (the same seed gives the same crop)
+*/
+void AutocropSuh::setSeed(uint64_t seed) {
+	this->seed = seed;
+}
+
+/*
+* Method for resetting ROI to whole image (the same instance can be used for more crops, e.g. more targets)
+*/
+void AutocropSuh::reset() {
+	this->x = 0;
+	this->y = 0;
+	this->width = this->salmap.cols;
+	this->height = this->salmap.rows;
+	this->topWindows.clear();
+	// score map belongs only to the last dense crop
+	this->scoreMap.release();
+}
+
+/*
+* Setter function for number of returned crops (pool of the best ROIs is kept only if k > 1, one ROI per region of image)
+*/
+void AutocropSuh::setTopK(int k) {
+	this->topK = std::max(1, k);
+	// pool keeps only the best window of each region, so it is not filled with small shifts of the best window
+	this->topWindows = TopKWindows((this->topK > 1) ? this->topK * TOPK_POOL_FACTOR : 0,
+		std::max(1, this->salmap.cols / TOPK_REGIONS), std::max(1, this->salmap.rows / TOPK_REGIONS));
+}
+
+/*
+* Getter function for the best distinct crops (the first one is final crop, IoU of any two crops is at most TOPK_MAX_IOU)
+*/
+std::vector<cv::Rect> AutocropSuh::getTopCandidates() {
+	std::vector<ScoredWindow> first(1, ScoredWindow(0.0, this->x, this->y, this->width, this->height));
+	std::vector<ScoredWindow> windows = this->topWindows.suppress(this->topK, first);
+
+	std::vector<cv::Rect> rois;
+	for (size_t i = 0; i < windows.size(); i++)
+		rois.push_back(cv::Rect(windows[i].x, windows[i].y, windows[i].width, windows[i].height));
+	return rois;
+}
+
+/*
+* Getter function for map of saliency energy of all positions computed by the last dense method (empty if it was not used)
+*/
+cv::Mat AutocropSuh::getScoreMap() {
+	return this->scoreMap;
 }
\ No newline at end of file
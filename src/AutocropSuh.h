@@ -12,7 +12,15 @@
 
 #include <array>
 #include <cmath>
+#include <sstream>
 #include <opencv2/opencv.hpp>
+#include "SaliencyIntegral.h"
+#include "ParallelReduction.h"
+#include "PyramidSearch.h"
+#include "SaliencyPeakIndex.h"
+#include "RandomGenerator.h"
+#include "TopKWindows.h"
+#include "DenseScoreMap.h"
 
 using namespace std;
 using namespace cv;
@@ -23,6 +31,9 @@ const int DEFAULT_STEP_SUH = 10;
 /* minimum size of roi */
 const float MAX_SCALE_SUH = 0.4f;
 
+/* default number of area buckets in frontier of saliency energy vs. area */
+const int FRONTIER_BUCKETS = 100;
+
 
 class AutocropSuh
 {
@@ -36,12 +47,29 @@ public:
 	void bruteForceWHratio(int w, int h, float treshold, int hStep = DEFAULT_STEP_SUH, int vStep = DEFAULT_STEP_SUH);
 	void greedyGeneral(float treshold);
 	void bruteForceGeneral(float treshold);
+	void exactGeneral(float treshold, int hStep = 1, int vStep = 1);
+
+	// frontier of saliency energy vs. area (computed once, then any treshold or area budget is only lookup)
+	void computeFrontier(int hStep = DEFAULT_STEP_SUH, int vStep = DEFAULT_STEP_SUH, int buckets = FRONTIER_BUCKETS);
+	bool frontierByThreshold(float treshold);
+	bool frontierByArea(float maxArea);
+	void saveFrontier(std::string filepath);
+	bool loadFrontier(std::string filepath, int hStep = DEFAULT_STEP_SUH, int vStep = DEFAULT_STEP_SUH, int buckets = FRONTIER_BUCKETS);
+	void pyramidWH(int w, int h, int hStep = DEFAULT_STEP_SUH, int vStep = DEFAULT_STEP_SUH);
+	void pyramidScale(float scale, int hStep = DEFAULT_STEP_SUH, int vStep = DEFAULT_STEP_SUH);
+	void denseWH(int w, int h);
+	void denseScale(float scale);
 
 	// getters and setters of ROI parameters
 	int getX();
 	int getY();
 	int getWidth();
 	int getHeight();
+	void setSeed(uint64_t seed);
+	void reset();
+	void setTopK(int k);
+	std::vector<cv::Rect> getTopCandidates();
+	cv::Mat getScoreMap();
 
 private:
 	// ROI parameters
@@ -51,10 +79,30 @@ private:
 	int height;
 	// saliency map of original image
 	cv::Mat salmap;
+	// map of saliency energy of all positions (dense methods)
+	cv::Mat scoreMap;
+	// seed for random generators
+	uint64_t seed;
+	// number of returned crops and pool of the best ROIs
+	int topK;
+	TopKWindows topWindows;
+	// the best ROI for each area bucket (score = ratio of saliency energy)
+	std::vector<ScoredWindow> frontier;
+	// steps of grid used for computing frontier
+	int frontierHStep;
+	int frontierVStep;
+	// summed-area table of saliency map (computed only once)
+	SaliencyIntegral integral;
 	// total saliency energy in whole original image
-	uint32_t totalSaliency;
+	uint64_t totalSaliency;
 	// method for computing saliency energy of defined ROI
-	uint32_t computeSaliency(int x1, int y1, int w, int h);
+	uint64_t computeSaliency(int x1, int y1, int w, int h);
+	// method for computing fingerprint of saliency map (hash of its values)
+	std::string salmapFingerprint();
+	// method for finding ROI with the highest saliency energy for defined width and height
+	ScoredWindow bestWindowWH(int w, int h, int hStep, int vStep, TopKWindows& topPool);
+	// method for finding ROI with the smallest area that satisfies treshold (two-pointer sweep through grid)
+	ScoredWindow minimalWindows(uint64_t tresholdSum, int minWidth, int minHeight, int hStep, int vStep, double maxArea, TopKWindows& topPool);
 };
 
 #endif //__AUTOCROPSUH_H__
@@ -0,0 +1,139 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: BoundaryScorer.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "BoundaryScorer.h"
+
+/**
+ * Constructor (scorer without gradient image)
+ */
+BoundaryScorer::BoundaryScorer() {
+	this->imageCols = 0;
+	this->imageRows = 0;
+	this->cols = 0;
+	this->rows = 0;
+	this->scaleX = 1.0;
+	this->scaleY = 1.0;
+}
+
+
+/**
+ * Method for computing prefix sums of gradient image in rows and in columns.
+ * Both tables are walked through row by row, sum of any horizontal or vertical segment is then difference of two values.
+ * @param gradient Gradient image CV_8UC1 (the same or lower resolution than original image)
+ * @param imageCols Width of original image
+ * @param imageRows Height of original image
+ */
+void BoundaryScorer::compute(cv::Mat gradient, int imageCols, int imageRows) {
+	CV_Assert(gradient.type() == CV_8UC1);
+
+	this->imageCols = imageCols;
+	this->imageRows = imageRows;
+	this->cols = gradient.cols;
+	this->rows = gradient.rows;
+	this->scaleX = (double)gradient.cols / imageCols;
+	this->scaleY = (double)gradient.rows / imageRows;
+
+	// sums of row segments [0,i) in each row (rows x cols+1)
+	this->rowSums.assign((size_t)this->rows * (this->cols + 1), 0);
+	// sums of column segments [0,j) in each column (rows+1 x cols), first row stays zero
+	this->colSums.assign((size_t)(this->rows + 1) * this->cols, 0);
+
+	for (int j = 0; j < this->rows; j++) {
+		const uint8_t* pGrad = gradient.ptr<uint8_t>(j);
+		uint32_t* pRow = &this->rowSums[(size_t)j * (this->cols + 1)];
+		const uint32_t* pAbove = &this->colSums[(size_t)j * this->cols];
+		uint32_t* pCol = &this->colSums[(size_t)(j + 1) * this->cols];
+
+		for (int i = 0; i < this->cols; i++) {
+			pRow[i + 1] = pRow[i] + pGrad[i];
+			pCol[i] = pAbove[i] + pGrad[i];
+		}
+	}
+}
+
+
+/**
+ * Method for computing boundary simplicity of all candidates in batch
+ * @param batch Batch of candidates (inside of original image)
+ */
+void BoundaryScorer::score(CandidateBatch& batch) {
+	const int count = batch.size();
+	batch.boundary.resize(count);
+
+	const int* px = batch.x.data();
+	const int* py = batch.y.data();
+	const int* pw = batch.width.data();
+	const int* ph = batch.height.data();
+	double* pScores = batch.boundary.data();
+
+#pragma omp parallel for
+	for (int i = 0; i < count; i++)
+		pScores[i] = this->boundarySimplicity(px[i], py[i], pw[i], ph[i]);
+}
+
+
+/**
+ * Method for computing boundary simplicity value of selected ROI
+ * @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+ * @param y1 Vertical coordinate(y-axis) of ROI top left corner
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @return Boundary simplicity value of defined ROI
+ */
+float BoundaryScorer::boundarySimplicity(int x1, int y1, int w, int h) const {
+	uint32_t score = 0;
+	uint32_t pixels = 0;
+
+	// right bottom corner of ROI
+	int x2 = x1 + w - 1;
+	int y2 = y1 + h - 1;
+
+	// input condition
+	if (this->imageCols <= x2)
+		return 0;
+	if (this->imageRows <= y2)
+		return 0;
+
+	// corners of ROI in resolution of gradient image (border is 2 pixels wide at this resolution)
+	if (this->scaleX != 1.0 || this->scaleY != 1.0) {
+		x1 = (int)(x1 * this->scaleX);
+		y1 = (int)(y1 * this->scaleY);
+		x2 = std::min((int)(x2 * this->scaleX), this->cols - 1);
+		y2 = std::min((int)(y2 * this->scaleY), this->rows - 1);
+	}
+
+	const size_t rowStride = (size_t)this->cols + 1;
+	const size_t colStride = (size_t)this->cols;
+
+	if (x1 < x2) {
+		// top bound and bottom bound (2 pixels wide), pixels from x1 to x2-1 in each row
+		const int bounds[4] = { y1, y1 + 1, y2 - 1, y2 };
+		for (int k = 0; k < 4; k++) {
+			const uint32_t* pRow = &this->rowSums[bounds[k] * rowStride];
+			score += pRow[x2] - pRow[x1];
+		}
+		
+		// increment number of pixels
+		pixels += 4 * (x2 - x1);
+	}
+
+	if ((y1 + 2) < (y2 - 2)) {
+		// left bound and right bound (2 pixels wide), pixels from y1+2 to y2-3 in each column
+		const uint32_t* pTop = &this->colSums[(y1 + 2) * colStride];
+		const uint32_t* pBottom = &this->colSums[(y2 - 2) * colStride];
+		const int bounds[4] = { x1, x1 + 1, x2 - 1, x2 };
+		for (int k = 0; k < 4; k++)
+			score += pBottom[bounds[k]] - pTop[bounds[k]];
+		
+		// increment number of pixels
+		pixels += 4 * ((y2 - 2) - (y1 + 2));
+	}
+
+	return (float)score / (float)pixels;
+}
@@ -0,0 +1,53 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: BoundaryScorer.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __BOUNDARYSCORER_H__
+#define __BOUNDARYSCORER_H__
+
+#include <vector>
+#include <cstdint>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "CandidateScorer.h"
+
+using namespace std;
+
+
+/**
+ * Scorer of boundary simplicity model (average gradient of 2 pixels wide border of ROI, lower value means simpler border).
+ * Prefix sums of gradient in rows and in columns are computed once, border of any ROI then costs 16 lookups.
+ * Gradient can have lower resolution than original image, ROIs are mapped to gradient resolution.
+ */
+class BoundaryScorer : public CandidateScorer
+{
+public:
+	// constructor (empty scorer)
+	BoundaryScorer();
+	// method for (re)computing prefix sums of gradient image of original image with defined size
+	void compute(cv::Mat gradient, int imageCols, int imageRows);
+	void score(CandidateBatch& batch);
+	// boundary simplicity of one ROI (ROI is in coordinates of original image)
+	float boundarySimplicity(int x1, int y1, int w, int h) const;
+
+private:
+	// size of original image
+	int imageCols;
+	int imageRows;
+	// size of gradient image
+	int cols;
+	int rows;
+	// ratio of gradient image and original image resolution
+	double scaleX;
+	double scaleY;
+	// prefix sums of gradient image in rows (rows x cols+1) and in columns (rows+1 x cols)
+	std::vector<uint32_t> rowSums;
+	std::vector<uint32_t> colSums;
+};
+
+#endif //__BOUNDARYSCORER_H__
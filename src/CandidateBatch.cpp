@@ -0,0 +1,99 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: CandidateBatch.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "CandidateBatch.h"
+
+/**
+ * Method for reserving memory of coordinates
+ * @param count Expected number of candidates
+ */
+void CandidateBatch::reserve(int count) {
+	this->x.reserve(count);
+	this->y.reserve(count);
+	this->width.reserve(count);
+	this->height.reserve(count);
+}
+
+
+/**
+ * Method for resizing batch, new slots are empty (zero size) and all scores are cleared
+ * @param count Number of candidates
+ */
+void CandidateBatch::resize(int count) {
+	this->x.resize(count, 0);
+	this->y.resize(count, 0);
+	this->width.resize(count, 0);
+	this->height.resize(count, 0);
+	this->content.clear();
+	this->boundary.clear();
+	this->composition.clear();
+	this->attention.clear();
+}
+
+
+/**
+ * Method for removing all candidates and scores
+ */
+void CandidateBatch::clear() {
+	this->resize(0);
+}
+
+
+/**
+ * Method for appending candidates of other batch (scores are appended only if both batches have them)
+ * @param other Batch of candidates
+ */
+void CandidateBatch::append(const CandidateBatch& other) {
+	const bool wasEmpty = this->empty();
+	this->x.insert(this->x.end(), other.x.begin(), other.x.end());
+	this->y.insert(this->y.end(), other.y.begin(), other.y.end());
+	this->width.insert(this->width.end(), other.width.begin(), other.width.end());
+	this->height.insert(this->height.end(), other.height.begin(), other.height.end());
+
+	// score column stays valid only if it has value for each candidate
+	std::vector<double>* columns[4] = { &this->content, &this->boundary, &this->composition, &this->attention };
+	const std::vector<double>* otherColumns[4] = { &other.content, &other.boundary, &other.composition, &other.attention };
+	for (int k = 0; k < 4; k++) {
+		if ((wasEmpty || !columns[k]->empty()) && otherColumns[k]->size() == other.x.size())
+			columns[k]->insert(columns[k]->end(), otherColumns[k]->begin(), otherColumns[k]->end());
+		else
+			columns[k]->clear();
+	}
+}
+
+
+/**
+ * Method for removing empty slots (candidates with zero size), order of other candidates is kept
+ */
+void CandidateBatch::removeEmpty() {
+	std::vector<double>* columns[4] = { &this->content, &this->boundary, &this->composition, &this->attention };
+	int k = 0;
+	for (int i = 0; i < this->size(); i++) {
+		if (this->width[i] <= 0 || this->height[i] <= 0)
+			continue;
+
+		this->set(k, this->x[i], this->y[i], this->width[i], this->height[i]);
+		for (int c = 0; c < 4; c++) {
+			if (columns[c]->size() == this->x.size())
+				(*columns[c])[k] = (*columns[c])[i];
+		}
+		k++;
+	}
+
+	for (int c = 0; c < 4; c++) {
+		if (columns[c]->size() == this->x.size())
+			columns[c]->resize(k);
+		else
+			columns[c]->clear();
+	}
+	this->x.resize(k);
+	this->y.resize(k);
+	this->width.resize(k);
+	this->height.resize(k);
+}
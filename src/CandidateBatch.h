@@ -0,0 +1,80 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: CandidateBatch.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __CANDIDATEBATCH_H__
+#define __CANDIDATEBATCH_H__
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "ParallelReduction.h"
+
+using namespace std;
+
+
+/**
+ * Batch of cropping candidates stored as structure of arrays.
+ * Coordinates and scores of all models are contiguous columns, so scorers walk through batch without gathering
+ * and croppers can share generated candidates. Candidates can be written from parallel loop by index (resize first),
+ * empty slots (zero size) are then removed by removeEmpty. Score columns are filled by scorers (see CandidateScorer).
+ */
+struct CandidateBatch
+{
+	// ROI of candidates
+	std::vector<int> x;
+	std::vector<int> y;
+	std::vector<int> width;
+	std::vector<int> height;
+	// scores of candidates (the column is empty until it is computed by scorer)
+	std::vector<double> content;		// ratio of saliency energy of ROI and image (content preservation model)
+	std::vector<double> boundary;		// average gradient of ROI border (boundary simplicity model, lower is better)
+	std::vector<double> composition;	// raw output of SVM (visual composition model, lower is better)
+	std::vector<double> attention;		// average saliency of pixel in ROI (Stentiford's attention score)
+
+	// number of candidates
+	int size() const {
+		return (int)this->x.size();
+	}
+
+	bool empty() const {
+		return this->x.empty();
+	}
+
+	// appends candidate (scores are not computed)
+	void push(int x1, int y1, int w, int h) {
+		this->x.push_back(x1);
+		this->y.push_back(y1);
+		this->width.push_back(w);
+		this->height.push_back(h);
+	}
+
+	// writes candidate to defined slot (e.g. index of iteration in parallel loop)
+	void set(int i, int x1, int y1, int w, int h) {
+		this->x[i] = x1;
+		this->y[i] = y1;
+		this->width[i] = w;
+		this->height[i] = h;
+	}
+
+	cv::Rect rect(int i) const {
+		return cv::Rect(this->x[i], this->y[i], this->width[i], this->height[i]);
+	}
+
+	ScoredWindow window(int i, double score) const {
+		return ScoredWindow(score, this->x[i], this->y[i], this->width[i], this->height[i]);
+	}
+
+	// methods for managing whole batch
+	void reserve(int count);
+	void resize(int count);
+	void clear();
+	void append(const CandidateBatch& other);
+	void removeEmpty();
+};
+
+#endif //__CANDIDATEBATCH_H__
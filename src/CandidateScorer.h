@@ -0,0 +1,28 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: CandidateScorer.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __CANDIDATESCORER_H__
+#define __CANDIDATESCORER_H__
+
+#include "CandidateBatch.h"
+
+
+/**
+ * Interface of model that evaluates whole batch of candidates at once and writes results to its score column
+ * (content, boundary, composition or attention). All candidates of batch must be inside of image.
+ */
+class CandidateScorer
+{
+public:
+	virtual ~CandidateScorer() {}
+	// computes score of all candidates in batch
+	virtual void score(CandidateBatch& batch) = 0;
+};
+
+#endif //__CANDIDATESCORER_H__
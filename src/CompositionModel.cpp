@@ -21,6 +21,8 @@
 CompositionModel::CompositionModel() {
 	this->featMat = Mat(Size(FEATS_COUNT, 0), CV_32FC1);
 	this->classMat = Mat(Size(1, 0), CV_32FC1);
+	// random generators are initialized with actual time, if seed is not defined
+	this->seed = RandomGenerator::timeSeed();
 }
 
 
@@ -40,12 +42,17 @@ void CompositionModel::fullTrainingPipeline(fs::path srcDir, std::string trained
 * @param srcDir Path to dataset folder with well composed images.
 */
 void CompositionModel::createFeatureMat(fs::path srcDir) {
-	srand((unsigned int)time(NULL));
 	// save paths for all images in training dataset of well composed images
 	std::vector<fs::path> paths = this->getImagePaths(srcDir);
+	// feature vectors of each image are saved to its own position and added to feature matrix after parallel loop
+	std::vector<cv::Mat> goodFeats(paths.size());
+	std::vector<cv::Mat> badFeats(paths.size());
 
 #pragma omp parallel for
 	for (int i = 0; i < paths.size(); i++) {
+		// each image has its own random sequence
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_TRAINING, i);
+
 		std::cout << i << ") Processing " << paths.at(i).string() << std::endl;	// full path
 		//std::cout << "filename and extension: " << paths.at(i).filename() << std::endl; // img.jpg
 		//std::cout << "filename only: " << paths.at(i).stem() << std::endl;     // img
@@ -59,8 +66,7 @@ void CompositionModel::createFeatureMat(fs::path srcDir) {
 		// generate saliency map of well composed image
 		SalMapMargolin saliency(img);
 		// add well composed image as feature vector
-		cv::Mat fVecGood = this->getFeatureVector(saliency.salMap);
-		this->addFeatureVector(fVecGood, GOOD_CROP);
+		goodFeats.at(i) = this->getFeatureVector(saliency.salMap);
 
 		// randomly generated crop should be bad composed => define area and content conditions
 		float sumSaliency = (float)sum(saliency.salMap)[0];
@@ -69,7 +75,7 @@ void CompositionModel::createFeatureMat(fs::path srcDir) {
 		cv::Mat badCrop;
 
 		while (true) {
-			rect = this->randomCrop(saliency.salMap); // create random ROI for crop
+			rect = this->randomCrop(saliency.salMap, rng); // create random ROI for crop
 			badCrop = saliency.salMap(rect); // crop defined ROI
 
 			// saliency ratio = bad cropped image : original image
@@ -80,8 +86,7 @@ void CompositionModel::createFeatureMat(fs::path srcDir) {
 			if (S_content < 0.25 && S_area > 0.25)  // conditions mean that the crop will be probably bad
 			{
 				// add bad composed crop as feature vector
-				cv::Mat fVecBad = this->getFeatureVector(badCrop);
-				this->addFeatureVector(fVecBad, BAD_CROP);
+				badFeats.at(i) = this->getFeatureVector(badCrop);
 				// possibly save bad crop
 				/* std::string path = srcDir.string() + "/badCrops21/" + paths.at(i).stem().string() + ".jpg";
 				std::cout << "Saving bad composed image " << path << std::endl;
@@ -91,6 +96,14 @@ void CompositionModel::createFeatureMat(fs::path srcDir) {
 		}
 	}
 
+	// add feature vectors in the same order as images (shared matrices are not modified from more threads)
+	for (int i = 0; i < paths.size(); i++) {
+		if (goodFeats.at(i).empty() || badFeats.at(i).empty())
+			continue;
+		this->addFeatureVector(goodFeats.at(i), GOOD_CROP);
+		this->addFeatureVector(badFeats.at(i), BAD_CROP);
+	}
+
 	// save feature matrix to file storage(format .yml)
 	FileStorage fs = FileStorage(srcDir.string() + "/FeatMat.yml", FileStorage::WRITE | FileStorage::FORMAT_YAML);
 	cv::write(fs, "features", this->featMat);
@@ -162,16 +175,88 @@ cv::Mat CompositionModel::getFeatureVector(cv::Mat saliency) {
 	// pointer to first pixel data
 	float* p_feats = feats.ptr<float>(0);
 
+	// Store 1/64ths (or 1/16ths) as feature vector values
+	for (int i = 0; i < SPSM_CELLS * SPSM_CELLS; i++)
+		p_feats[i] = p_saliency[i];
+
+	// other levels of pyramid are averages of finer level
+	this->addPyramidLevels(p_feats);
+
+	return feats;
+}
+
+
+/**
+* Computes feature vector of ROI directly from summed-area table of saliency map (no crop and resize of ROI).
+* Cells of the finest level are averages of saliency over regular grid of ROI, pixels on borders of cells are weighted
+* by covered area (the same as resize with INTER_AREA). Box sum at non-integer position is bilinear interpolation
+* of table, which is exact integral of saliency map, so each cell costs 4 lookups.
+* @param integral Summed-area table of saliency map CV_64F (size rows+1 x cols+1, see cv::integral)
+* @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+* @param y1 Vertical coordinate(y-axis) of ROI top left corner
+* @param w Width of ROI
+* @param h Height of ROI
+* @param p_feats Output feature vector (FEATS_COUNT values, e.g. row of batch feature matrix)
+* @return False if ROI is smaller than grid of cells (resize would interpolate, use getFeatureVector), else True
+*/
+bool CompositionModel::getFeatureVectorIntegral(const cv::Mat& integral, int x1, int y1, int w, int h, float* p_feats) {
+	if (w < SPSM_CELLS || h < SPSM_CELLS)
+		return false;
+
+	// integral of saliency map over [0,X) x [0,Y) for real X,Y
+	auto area = [&integral](double X, double Y) -> double {
+		int i = std::min((int)X, integral.cols - 2);
+		int j = std::min((int)Y, integral.rows - 2);
+		double fx = X - i;
+		double fy = Y - j;
+		const double* row0 = integral.ptr<double>(j);
+		const double* row1 = integral.ptr<double>(j + 1);
+		return (1.0 - fy) * ((1.0 - fx) * row0[i] + fx * row0[i + 1]) + fy * ((1.0 - fx) * row1[i] + fx * row1[i + 1]);
+	};
+
+	const double cellW = (double)w / SPSM_CELLS;
+	const double cellH = (double)h / SPSM_CELLS;
+
+	// borders of cells
+	double xs[SPSM_CELLS + 1];
+	double ys[SPSM_CELLS + 1];
+	for (int k = 0; k <= SPSM_CELLS; k++) {
+		xs[k] = x1 + k * cellW;
+		ys[k] = y1 + k * cellH;
+	}
+	xs[SPSM_CELLS] = x1 + w;
+	ys[SPSM_CELLS] = y1 + h;
+
+	// table values at corners of cells
+	double corners[SPSM_CELLS + 1][SPSM_CELLS + 1];
+	for (int j = 0; j <= SPSM_CELLS; j++)
+		for (int k = 0; k <= SPSM_CELLS; k++)
+			corners[j][k] = area(xs[k], ys[j]);
+
+	// Store 1/64ths (or 1/16ths) as feature vector values
+	for (int j = 0; j < SPSM_CELLS; j++) {
+		for (int k = 0; k < SPSM_CELLS; k++) {
+			double sum = corners[j + 1][k + 1] - corners[j][k + 1] - corners[j + 1][k] + corners[j][k];
+			p_feats[j * SPSM_CELLS + k] = (float)(sum / (cellW * cellH));
+		}
+	}
+
+	// other levels of pyramid are averages of finer level
+	this->addPyramidLevels(p_feats);
+
+	return true;
+}
+
+
+/**
+* Computes coarser levels of spatial pyramid (averages of 2x2 cells of finer level)
+* @param p_feats Feature vector with the finest level already stored in first SPSM_CELLS * SPSM_CELLS values
+*/
+void CompositionModel::addPyramidLevels(float* p_feats) {
 	// Index in feature vector
-	int i = 0;
+	int i = SPSM_CELLS * SPSM_CELLS;
 	
 	if (FEATS_COUNT == 85) {
-		// Store 1/64ths as feature vector values
-		for (int j = 0; j < 64; j++) {
-			p_feats[i] = p_saliency[i];
-			i++;
-		}
-
 		// Average 1/64 values to get feature vector values for 1/16ths
 		for (int j = 0; j < 4; j++) {
 			for (int k = 0; k < 4; k++) {
@@ -195,12 +280,6 @@ cv::Mat CompositionModel::getFeatureVector(cv::Mat saliency) {
 		}
 	}
 	else {
-		// Store 1/16ths as feature vector values
-		for (int j = 0; j < 16; j++) {
-			p_feats[i] = p_saliency[i];
-			i++;
-		}
-
 		// Average 1/16 values to get feature vector values for 1/4ths
 		for (int j = 0; j < 2; j++) {
 			for (int k = 0; k < 2; k++) {
@@ -218,8 +297,6 @@ cv::Mat CompositionModel::getFeatureVector(cv::Mat saliency) {
 						p_feats[i - 3] +
 						p_feats[i - 2] +
 						p_feats[i - 1]);
-
-	return feats;
 }
 
 
@@ -267,15 +344,29 @@ void CompositionModel::train(std::string savepath) {
 
 	// save trained model
 	this->model->save(savepath);
+	this->linearScorer.extract(this->model);
 }
 
 
 /**
-* Loads trained model
-* @param filepath Path to file with trained model data (serialized SVM)
+* Loads trained model, files .yml/.yaml/.xml are loaded as serialized SVM, other files as binary model file
+* @param filepath Path to file with trained model data (serialized SVM or binary file of linear model)
 */
 void CompositionModel::loadTrainedModel(std::string filepath) {
 	std::cout << "Loading trained SVM model: " << filepath << std::endl;
+
+	std::string ext = fs::path(filepath).extension().string();
+	std::transform(ext.begin(), ext.end(), ext.begin(), ::tolower);
+	if (ext != ".yml" && ext != ".yaml" && ext != ".xml") {
+		// binary file is only mapped to memory, there is no instance of ml::SVM
+		this->model = cv::Ptr<cv::ml::SVM>();
+		if (!this->linearScorer.load(filepath) || this->linearScorer.getVarCount() != FEATS_COUNT) {
+			std::cerr << "Cannot load trained model: " << filepath << std::endl;
+			std::exit(EXIT_FAILURE);
+		}
+		return;
+	}
+
 	try {
 		this->model = ml::SVM::load(filepath);
 	}
@@ -283,6 +374,39 @@ void CompositionModel::loadTrainedModel(std::string filepath) {
 		std::cerr << "Cannot load trained model: " << filepath << std::endl;
 		std::exit(EXIT_FAILURE);
 	}
+
+	// weights of linear model are extracted only once, other models are evaluated by predict
+	this->linearScorer.extract(this->model);
+}
+
+
+/**
+* Uses default trained model that is compiled into application (see DefaultCompositionModel.h), no file is read
+*/
+void CompositionModel::loadDefaultModel() {
+	this->model = cv::Ptr<cv::ml::SVM>();
+	this->linearScorer.set(DEFAULT_MODEL_VAR_COUNT, DEFAULT_MODEL_SV_COUNT, DEFAULT_MODEL_RHO, DEFAULT_MODEL_ALPHA, DEFAULT_MODEL_SUPPORT_VECTORS);
+	CV_Assert(this->linearScorer.getVarCount() == FEATS_COUNT);
+}
+
+
+/**
+* Converts trained model from serialized SVM to binary model file (only linear model can be converted)
+* @param srcPath Path to file with trained model data (serialized SVM, e.g. .yml)
+* @param dstPath Path where binary model file will be saved
+*/
+void CompositionModel::convertTrainedModel(std::string srcPath, std::string dstPath) {
+	this->loadTrainedModel(srcPath);
+	if (!this->linearScorer.isValid()) {
+		std::cerr << "Only trained model with linear kernel can be converted: " << srcPath << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
+
+	std::cout << "Saving binary model: " << dstPath << std::endl;
+	if (!this->linearScorer.save(dstPath)) {
+		std::cerr << "Cannot save binary model: " << dstPath << std::endl;
+		std::exit(EXIT_FAILURE);
+	}
 }
 
 
@@ -293,6 +417,13 @@ void CompositionModel::loadTrainedModel(std::string filepath) {
 */
 float CompositionModel::classifyComposition(cv::Mat featVec)
 {
+	if (this->linearScorer.isValid() && featVec.channels() == 1 && (int)featVec.total() == this->linearScorer.getVarCount()) {
+		// predict converts features to CV_32F too (model from binary file has no instance of ml::SVM)
+		cv::Mat feat;
+		(featVec.isContinuous() ? featVec : featVec.clone()).reshape(1, 1).convertTo(feat, CV_32FC1);
+		return this->linearScorer.score(feat.ptr<float>(0));
+	}
+
 	// use flag StatModel::RAW_OUTPUT to get the raw response from SVM (in the case of regression)
 	cv::Mat result;
 	this->model->predict(featVec, result, ml::StatModel::RAW_OUTPUT);
@@ -301,22 +432,64 @@ float CompositionModel::classifyComposition(cv::Mat featVec)
 }
 
 
+/**
+* Classifies all rows of feature matrix at once
+* @param feats Batch feature matrix (one feature vector per row)
+* @return Composition scores in the same order as rows
+*/
+std::vector<float> CompositionModel::classifyCompositionBatch(const cv::Mat& feats)
+{
+	std::vector<float> scores(feats.rows);
+	if (feats.rows == 0)
+		return scores;
+
+	if (this->linearScorer.isValid() && feats.channels() == 1 && feats.cols == this->linearScorer.getVarCount()) {
+		if (feats.type() == CV_32FC1) {
+			this->linearScorer.score(feats, scores.data());
+		}
+		else {
+			cv::Mat feats32;
+			feats.convertTo(feats32, CV_32FC1);
+			this->linearScorer.score(feats32, scores.data());
+		}
+		return scores;
+	}
+
+	cv::Mat result;
+	this->model->predict(feats, result, ml::StatModel::RAW_OUTPUT);
+	for (int i = 0; i < feats.rows; i++)
+		scores[i] = result.at<float>(i, 0);
+
+	return scores;
+}
+
+
+/**
+* Setter function for seed of random generators used in training pipeline
+* @param seed Seed value (the same seed gives the same random crops)
+*/
+void CompositionModel::setSeed(uint64_t seed) {
+	this->seed = seed;
+}
+
+
 /**
 * Method for finding ROI to crop randomly -> it should represent bad composed image 
 * @param img Image to be cropped
+* @param rng Random generator of actual image
 * @return Rectangle that represents ROI to crop
 */
-cv::Rect CompositionModel::randomCrop(cv::Mat img) {
+cv::Rect CompositionModel::randomCrop(cv::Mat img, RandomGenerator& rng) {
 	// define minimum size
 	int minW = (int)(0.5 * img.cols);
 	int minH = (int)(0.5 * img.rows);
 
 	// generate random ROI
 	int x1, y1, w, h;
-	x1 = rand() % (img.cols - minW);
-	y1 = rand() % (img.rows - minH);
-	w = minW + (rand() % (img.cols - x1 - minW));
-	h = minH + (rand() % (img.rows - y1 - minH));
+	x1 = rng.uniform(img.cols - minW);
+	y1 = rng.uniform(img.rows - minH);
+	w = minW + rng.uniform(img.cols - x1 - minW);
+	h = minH + rng.uniform(img.rows - y1 - minH);
 
 	return cv::Rect(x1, y1, w, h);
 }
@@ -16,6 +16,9 @@
 #include "boost/filesystem.hpp"
 
 #include "SalMapMargolin.h"
+#include "RandomGenerator.h"
+#include "LinearSvmScorer.h"
+#include "DefaultCompositionModel.h"
 
 namespace fs = boost::filesystem;
 using namespace std;
@@ -28,6 +31,8 @@ const int BAD_CROP = 0;
 /* count of features used for training and classifying in Visual composition model */
 //const int FEATS_COUNT = 85; // SPSM 8x8 + 4x4 + 2x2 + 1x1
 const int FEATS_COUNT = 21; // SPSM 4x4 + 2x2 + 1x1
+/* number of cells in one row of the finest level of spatial pyramid */
+const int SPSM_CELLS = (FEATS_COUNT == 85) ? 8 : 4;
 
 
 class CompositionModel
@@ -43,20 +48,32 @@ public:
 	void loadFeatureMat(std::string filepath);
 	void addFeatureVector(cv::Mat saliency, int cls);
 	cv::Mat getFeatureVector(cv::Mat saliency);
+	bool getFeatureVectorIntegral(const cv::Mat& integral, int x1, int y1, int w, int h, float* p_feats);
 	// method for training and mananing SVM model
 	void train(std::string savepath);
 	void loadTrainedModel(std::string filepath);
+	void loadDefaultModel();
+	void convertTrainedModel(std::string srcPath, std::string dstPath);
 	float classifyComposition(cv::Mat featVec);
+	std::vector<float> classifyCompositionBatch(const cv::Mat& feats);
+	// setter of seed for random generators
+	void setSeed(uint64_t seed);
 
 private:
 	// matrix/vectors with features and classes
 	cv::Mat featMat;
 	cv::Mat classMat;
-	// SVM model
+	// SVM model (empty if model was loaded from binary file or compiled default model is used)
 	cv::Ptr<cv::ml::SVM> model;
+	// fast evaluation of linear model (not valid for other kernels)
+	LinearSvmScorer linearScorer;
+	// seed for random generators
+	uint64_t seed;
 	
+	// method for computing coarser levels of spatial pyramid
+	void addPyramidLevels(float* p_feats);
 	// other methods that are used for operations with images in training pipeline
-	cv::Rect randomCrop(cv::Mat img);
+	cv::Rect randomCrop(cv::Mat img, RandomGenerator& rng);
 	cv::Mat loadImgReduced(std::string path);
 	std::vector<fs::path> getImagePaths(fs::path dir);
 };
@@ -0,0 +1,66 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: CompositionScorer.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "CompositionScorer.h"
+
+/**
+ * Constructor
+ * @param model Visual composition model with loaded trained SVM
+ */
+CompositionScorer::CompositionScorer(CompositionModel& model) : model(model) {
+}
+
+
+/**
+ * Method for computing summed-area table of saliency map
+ * @param salMap Saliency map CV_32F
+ */
+void CompositionScorer::compute(cv::Mat salMap) {
+	this->salMap = salMap;
+	cv::integral(this->salMap, this->salMapIntegral, CV_64F);
+}
+
+
+/**
+ * Method for computing visual composition score of all candidates in batch
+ * (feature matrix is local, so more batches can be scored at once from different threads)
+ * @param batch Batch of candidates (inside of saliency map)
+ */
+void CompositionScorer::score(CandidateBatch& batch) {
+	const int count = batch.size();
+	cv::Mat feats(count, FEATS_COUNT, CV_32FC1);
+
+#pragma omp parallel for
+	for (int i = 0; i < count; i++)
+		this->features(batch.x[i], batch.y[i], batch.width[i], batch.height[i], feats.ptr<float>(i));
+
+	// the lowest value means the best composition
+	std::vector<float> scores = this->model.classifyCompositionBatch(feats);
+	batch.composition.assign(scores.begin(), scores.end());
+}
+
+
+/**
+ * Method for computing feature vector of ROI from summed-area table of saliency map
+ * (crop and resize of ROI is used only for ROIs smaller than grid of spatial pyramid)
+ * @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+ * @param y1 Vertical coordinate(y-axis) of ROI top left corner
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @param p_feats Output feature vector (FEATS_COUNT values)
+ */
+void CompositionScorer::features(int x1, int y1, int w, int h, float* p_feats) {
+	if (this->model.getFeatureVectorIntegral(this->salMapIntegral, x1, y1, w, h, p_feats))
+		return;
+
+	// create rectangle of defined ROI
+	cv::Rect rect = cv::Rect(x1, y1, w, h);
+	cv::Mat fvec = this->model.getFeatureVector(this->salMap(rect));
+	std::copy(fvec.ptr<float>(0), fvec.ptr<float>(0) + FEATS_COUNT, p_feats);
+}
@@ -0,0 +1,43 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: CompositionScorer.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __COMPOSITIONSCORER_H__
+#define __COMPOSITIONSCORER_H__
+
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "CandidateScorer.h"
+#include "CompositionModel.h"
+
+
+/**
+ * Scorer of visual composition model. Feature vectors of all candidates are computed from summed-area table
+ * of saliency map into one matrix and trained model is evaluated once for whole batch.
+ */
+class CompositionScorer : public CandidateScorer
+{
+public:
+	// constructor
+	CompositionScorer(CompositionModel& model);
+	// method for (re)computing summed-area table of saliency map
+	void compute(cv::Mat salMap);
+	void score(CandidateBatch& batch);
+	// feature vector of one ROI (FEATS_COUNT values)
+	void features(int x1, int y1, int w, int h, float* p_feats);
+
+private:
+	// trained visual composition model
+	CompositionModel& model;
+	// saliency map CV_32F
+	cv::Mat salMap;
+	// summed-area table of saliency map (CV_64F values, size rows+1 x cols+1)
+	cv::Mat salMapIntegral;
+};
+
+#endif //__COMPOSITIONSCORER_H__
@@ -0,0 +1,42 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: DefaultCompositionModel.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __DEFAULTCOMPOSITIONMODEL_H__
+#define __DEFAULTCOMPOSITIONMODEL_H__
+
+/**
+ * Default trained model of Visual composition (models/Trained_model21.yml) compiled into application,
+ * so Fang's algorithm does not need any file. Model is linear SVM with 21 features (SPSM 4x4 + 2x2 + 1x1)
+ * compressed to one support vector. Values are written exactly as in .yml file and converted the same way
+ * as in cv::FileStorage (decimal number => double => float), so scores are identical to loaded model.
+ * (when model is trained again, values have to be replaced with values of new .yml file)
+ */
+
+/* length of feature vector and number of support vectors */
+constexpr int DEFAULT_MODEL_VAR_COUNT = 21;
+constexpr int DEFAULT_MODEL_SV_COUNT = 1;
+
+/* bias of decision function (rho) */
+constexpr double DEFAULT_MODEL_RHO = -1.8516246048261298e-05;
+
+/* weights of support vectors (alpha) */
+constexpr double DEFAULT_MODEL_ALPHA[DEFAULT_MODEL_SV_COUNT] = { 1. };
+
+/* support vectors (one per row) */
+constexpr float DEFAULT_MODEL_SUPPORT_VECTORS[DEFAULT_MODEL_SV_COUNT * DEFAULT_MODEL_VAR_COUNT] = {
+	-4.47340381e-06, -1.80414481e-05, -1.93626656e-05,
+	1.45133408e-05, 1.38095138e-05, -4.20765318e-05,
+	-2.95008704e-05, -1.04050268e-05, 4.59390958e-06,
+	-3.31473384e-05, -9.18830847e-06, 5.97219696e-06,
+	2.04540756e-05, -1.39244394e-05, -1.42981717e-05,
+	1.79416038e-05, -1.26955165e-05, -1.11888021e-05,
+	-5.50600998e-06, 1.06873195e-07, -7.32087801e-06
+};
+
+#endif //__DEFAULTCOMPOSITIONMODEL_H__
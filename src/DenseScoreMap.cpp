@@ -0,0 +1,118 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: DenseScoreMap.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "DenseScoreMap.h"
+
+/**
+ * Constructor
+ * @param sm Saliency map CV_8UC1
+ */
+DenseScoreMap::DenseScoreMap(cv::Mat sm) {
+	CV_Assert(sm.type() == CV_8UC1);
+	this->salMap = sm;
+}
+
+
+/**
+ * Method for computing saliency energy of ROI with defined width and height at every position
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @return Map CV_64F, element (y,x) is saliency energy of ROI with top left corner (x,y) (empty map for invalid size)
+ */
+cv::Mat DenseScoreMap::computeWH(int w, int h) {
+	const int cols = this->salMap.cols;
+	const int rows = this->salMap.rows;
+	if (w <= 0 || h <= 0 || w > cols || h > rows)
+		return cv::Mat();
+
+	const int outCols = cols - w + 1;
+	const int outRows = rows - h + 1;
+
+	/* horizontal pass - sum of w pixels in row for every x (max 255 * cols, fits to int) */
+	cv::Mat rowSums(rows, outCols, CV_32SC1);
+#pragma omp parallel for
+	for (int j = 0; j < rows; j++) {
+		const uint8_t* pSal = this->salMap.ptr<uint8_t>(j);
+		int* pSum = rowSums.ptr<int>(j);
+
+		int sum = 0;
+		for (int i = 0; i < w; i++)
+			sum += pSal[i];
+		pSum[0] = sum;
+
+		// add pixel entering window and subtract pixel leaving window
+		for (int i = 1; i < outCols; i++) {
+			sum += pSal[i + w - 1] - pSal[i - 1];
+			pSum[i] = sum;
+		}
+	}
+
+	/* vertical pass - sum of h row sums for every y, columns are divided into blocks (rows are read sequentially) */
+	cv::Mat scores(outRows, outCols, CV_64FC1);
+	const int blocks = (outCols + DENSE_COLUMN_BLOCK - 1) / DENSE_COLUMN_BLOCK;
+#pragma omp parallel for
+	for (int b = 0; b < blocks; b++) {
+		const int x1 = b * DENSE_COLUMN_BLOCK;
+		const int x2 = std::min(outCols, x1 + DENSE_COLUMN_BLOCK);
+		// sums are integers, double is exact up to 2^53
+		std::vector<double> acc(x2 - x1, 0.0);
+
+		for (int j = 0; j < h; j++) {
+			const int* pSum = rowSums.ptr<int>(j);
+			for (int i = x1; i < x2; i++)
+				acc[i - x1] += pSum[i];
+		}
+		double* pOut = scores.ptr<double>(0);
+		for (int i = x1; i < x2; i++)
+			pOut[i] = acc[i - x1];
+
+		// add row entering window and subtract row leaving window
+		for (int j = 1; j < outRows; j++) {
+			const int* pIn = rowSums.ptr<int>(j + h - 1);
+			const int* pLeave = rowSums.ptr<int>(j - 1);
+			pOut = scores.ptr<double>(j);
+			for (int i = x1; i < x2; i++) {
+				acc[i - x1] += (double)(pIn[i] - pLeave[i]);
+				pOut[i] = acc[i - x1];
+			}
+		}
+	}
+
+	return scores;
+}
+
+
+/**
+ * Method for finding the best position in map of saliency energy
+ * @param scores Map computed by computeWH
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @param pool Pool where the best windows are saved (pool with zero capacity is not filled)
+ * @return The best ROI (invalid window for empty map)
+ */
+ScoredWindow DenseScoreMap::bestWindow(const cv::Mat& scores, int w, int h, TopKWindows& pool) {
+	ScoredWindow best;
+	TopKWindows localPool = pool.emptyCopy();
+
+#pragma omp parallel for reduction(bestWindow : best) reduction(topWindows : localPool)
+	for (int j = 0; j < scores.rows; j++) {
+		const double* pScore = scores.ptr<double>(j);
+		for (int i = 0; i < scores.cols; i++) {
+			// most of positions are rejected without constructing window
+			if (pScore[i] >= best.score) {
+				best.update(ScoredWindow(pScore[i], i, j, w, h));
+			}
+			if (localPool.getCapacity() > 0)
+				localPool.push(ScoredWindow(pScore[i], i, j, w, h));
+		}
+	}
+
+	pool.merge(localPool);
+	return best;
+}
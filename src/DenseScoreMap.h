@@ -0,0 +1,46 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: DenseScoreMap.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __DENSESCOREMAP_H__
+#define __DENSESCOREMAP_H__
+
+#include <vector>
+#include <opencv2/opencv.hpp>
+#include "ParallelReduction.h"
+#include "TopKWindows.h"
+
+using namespace std;
+using namespace cv;
+
+/* number of columns processed by one thread in vertical pass */
+const int DENSE_COLUMN_BLOCK = 256;
+
+
+/**
+ * Saliency energy of ROI with fixed width and height at every position (stride 1px).
+ * Map is computed by two separable running sums (box filter): horizontal pass over rows and vertical pass
+ * over columns, so the cost is O(rows * cols) for any size of ROI. Element (y,x) of result is energy of ROI
+ * with top left corner (x,y), result can be displayed as heatmap of positions.
+ */
+class DenseScoreMap
+{
+public:
+	// constructor
+	DenseScoreMap(cv::Mat sm);
+	// returns map of saliency energy CV_64F with size (rows - h + 1) x (cols - w + 1)
+	cv::Mat computeWH(int w, int h);
+	// returns the best position in map (score of window is its saliency energy), the best windows are also saved to pool
+	static ScoredWindow bestWindow(const cv::Mat& scores, int w, int h, TopKWindows& pool);
+
+private:
+	// saliency map CV_8UC1
+	cv::Mat salMap;
+};
+
+#endif //__DENSESCOREMAP_H__
@@ -0,0 +1,271 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: LinearSvmScorer.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "LinearSvmScorer.h"
+
+/**
+ * Constructor (scorer is not valid until decision function is extracted)
+ */
+LinearSvmScorer::LinearSvmScorer() {
+	this->valid = false;
+	this->varCount = 0;
+	this->rho = 0.0;
+}
+
+
+/**
+ * Method for extracting decision function of linear two-class SVM
+ * @param svm Trained SVM model
+ * @return True if model is linear classifier and extracted function gives the same scores as predict, else False
+ */
+bool LinearSvmScorer::extract(const cv::Ptr<cv::ml::SVM>& svm) {
+	this->valid = false;
+	this->mapping.reset();
+	if (svm.get() == NULL || svm->getKernelType() != cv::ml::SVM::LINEAR)
+		return false;
+	if (svm->getType() != cv::ml::SVM::C_SVC && svm->getType() != cv::ml::SVM::NU_SVC)
+		return false;
+
+	cv::Mat sv = svm->getSupportVectors();
+	if (sv.empty() || sv.type() != CV_32FC1 || sv.cols > LINEAR_SVM_MAX_VARS)
+		return false;
+
+	// the first (for two classes the only one) decision function
+	cv::Mat dfAlpha, dfIndex;
+	this->rho = svm->getDecisionFunction(0, dfAlpha, dfIndex);
+	dfAlpha.convertTo(dfAlpha, CV_64F);
+	dfIndex.convertTo(dfIndex, CV_32S);
+
+	this->varCount = sv.cols;
+	this->supportVectors.create((int)dfAlpha.total(), this->varCount, CV_32FC1);
+	this->alpha.create(1, (int)dfAlpha.total(), CV_64FC1);
+	for (int k = 0; k < (int)dfAlpha.total(); k++) {
+		this->alpha.ptr<double>(0)[k] = dfAlpha.ptr<double>(0)[k];
+		cv::Mat row = this->supportVectors.row(k);
+		sv.row(dfIndex.ptr<int>(0)[k]).copyTo(row);
+	}
+
+	// probe vectors in range of saliency values, more classes or other differences of model are found here
+	cv::Mat probe(2 * LINEAR_SVM_LANES + 1, this->varCount, CV_32FC1);
+	RandomGenerator rng(0, RANDOM_DOMAIN_SVM_PROBE);
+	for (int i = 0; i < probe.rows; i++)
+		for (int k = 0; k < this->varCount; k++)
+			probe.at<float>(i, k) = (float)rng.uniformReal();
+	cv::Mat expected;
+	svm->predict(probe, expected, cv::ml::StatModel::RAW_OUTPUT);
+
+	this->valid = true;
+	std::vector<float> scores(probe.rows);
+	this->score(probe, scores.data());
+	for (int i = 0; i < probe.rows; i++) {
+		if (scores[i] != expected.at<float>(i, 0))
+			this->valid = false;
+	}
+
+	return this->valid;
+}
+
+
+/**
+ * Method for setting decision function from arrays (e.g. values compiled into application or mapped file)
+ * @param varCount Length of feature vector (at most LINEAR_SVM_MAX_VARS)
+ * @param svCount Number of support vectors
+ * @param rho Bias of decision function
+ * @param alpha Weights of support vectors (svCount values)
+ * @param supportVectors Support vectors (svCount rows with varCount values)
+ * @return True if decision function is valid, else False
+ */
+bool LinearSvmScorer::set(int varCount, int svCount, double rho, const double* alpha, const float* supportVectors) {
+	this->valid = false;
+	this->mapping.reset();
+	if (varCount <= 0 || varCount > LINEAR_SVM_MAX_VARS || svCount <= 0 || alpha == NULL || supportVectors == NULL)
+		return false;
+
+	this->varCount = varCount;
+	this->rho = rho;
+	// matrices only point to arrays, they are never modified
+	this->alpha = cv::Mat(1, svCount, CV_64FC1, (void*)alpha);
+	this->supportVectors = cv::Mat(svCount, varCount, CV_32FC1, (void*)supportVectors);
+	this->valid = true;
+
+	return true;
+}
+
+
+/**
+ * Method for loading decision function from binary model file (see LinearSvmFileHeader), file is mapped to memory
+ * @param filepath Path to binary model file
+ * @return True if file was loaded, else False
+ */
+bool LinearSvmScorer::load(const std::string& filepath) {
+	this->valid = false;
+	this->mapping.reset();
+
+	std::shared_ptr<boost::interprocess::mapped_region> region;
+	try {
+		boost::interprocess::file_mapping file(filepath.c_str(), boost::interprocess::read_only);
+		// mapped region stays valid when file mapping is closed
+		region = std::make_shared<boost::interprocess::mapped_region>(file, boost::interprocess::read_only);
+	}
+	catch (const boost::interprocess::interprocess_exception&) {
+		return false;
+	}
+
+	// check header and size of file
+	const char* data = (const char*)region->get_address();
+	size_t size = region->get_size();
+	if (size < sizeof(LinearSvmFileHeader))
+		return false;
+
+	LinearSvmFileHeader header;
+	std::memcpy(&header, data, sizeof(LinearSvmFileHeader));
+	if (std::memcmp(header.magic, LINEAR_SVM_FILE_MAGIC, sizeof(header.magic)) != 0 || header.version != LINEAR_SVM_FILE_VERSION)
+		return false;
+	if (header.varCount <= 0 || header.svCount <= 0 || header.varCount > LINEAR_SVM_MAX_VARS || header.svCount > (1 << 20))
+		return false;
+
+	size_t alphaSize = (size_t)header.svCount * sizeof(double);
+	size_t svSize = (size_t)header.svCount * header.varCount * sizeof(float);
+	if (size != sizeof(LinearSvmFileHeader) + alphaSize + svSize)
+		return false;
+
+	const double* alpha = (const double*)(data + sizeof(LinearSvmFileHeader));
+	const float* supportVectors = (const float*)(data + sizeof(LinearSvmFileHeader) + alphaSize);
+	if (!this->set(header.varCount, header.svCount, header.rho, alpha, supportVectors))
+		return false;
+
+	// matrices point into mapped file, so it has to be kept
+	this->mapping = region;
+	return true;
+}
+
+
+/**
+ * Method for saving decision function to binary model file (see LinearSvmFileHeader)
+ * @param filepath Path where binary model file will be saved
+ * @return True if file was saved, else False
+ */
+bool LinearSvmScorer::save(const std::string& filepath) const {
+	if (!this->valid)
+		return false;
+
+	std::ofstream file(filepath.c_str(), std::ios::out | std::ios::binary | std::ios::trunc);
+	if (!file.is_open())
+		return false;
+
+	LinearSvmFileHeader header;
+	std::memset(&header, 0, sizeof(LinearSvmFileHeader));
+	std::memcpy(header.magic, LINEAR_SVM_FILE_MAGIC, sizeof(header.magic));
+	header.version = LINEAR_SVM_FILE_VERSION;
+	header.varCount = this->varCount;
+	header.svCount = this->supportVectors.rows;
+	header.rho = this->rho;
+
+	file.write((const char*)&header, sizeof(LinearSvmFileHeader));
+	file.write((const char*)this->alpha.ptr<double>(0), (std::streamsize)this->supportVectors.rows * sizeof(double));
+	for (int j = 0; j < this->supportVectors.rows; j++)
+		file.write((const char*)this->supportVectors.ptr<float>(j), (std::streamsize)this->varCount * sizeof(float));
+
+	return file.good();
+}
+
+
+/**
+ * Method for scoring all feature vectors in matrix
+ * @param feats Matrix CV_32F with one feature vector per row
+ * @param scores Output scores (feats.rows values)
+ */
+void LinearSvmScorer::score(const cv::Mat& feats, float* scores) const {
+	CV_Assert(feats.type() == CV_32FC1 && feats.cols == this->varCount);
+
+	const float* rows[LINEAR_SVM_LANES];
+	for (int i = 0; i < feats.rows; i += LINEAR_SVM_LANES) {
+		int count = std::min(LINEAR_SVM_LANES, feats.rows - i);
+		for (int l = 0; l < count; l++)
+			rows[l] = feats.ptr<float>(i + l);
+		this->scoreBlock(rows, count, scores + i);
+	}
+}
+
+
+/**
+ * Method for scoring one feature vector
+ * @param feat Feature vector (varCount values)
+ * @return Score of feature vector (the same as RAW_OUTPUT of predict)
+ */
+float LinearSvmScorer::score(const float* feat) const {
+	float result;
+	this->scoreBlock(&feat, 1, &result);
+	return result;
+}
+
+
+/**
+ * Method for scoring block of feature vectors, vectors are transposed so each of them has its own lane
+ * @param rows Pointers to feature vectors
+ * @param count Number of feature vectors (at most LINEAR_SVM_LANES)
+ * @param scores Output scores
+ */
+void LinearSvmScorer::scoreBlock(const float* const* rows, int count, float* scores) const {
+	// transposed block on stack (unused lanes are zero)
+	float block[LINEAR_SVM_MAX_VARS * LINEAR_SVM_LANES];
+	std::fill(block, block + (size_t)this->varCount * LINEAR_SVM_LANES, 0.0f);
+	for (int l = 0; l < count; l++)
+		for (int k = 0; k < this->varCount; k++)
+			block[(size_t)k * LINEAR_SVM_LANES + l] = rows[l][k];
+	const float* x = block;
+
+	const double* alpha = this->alpha.ptr<double>(0);
+	double sum[LINEAR_SVM_LANES];
+	for (int l = 0; l < LINEAR_SVM_LANES; l++)
+		sum[l] = -this->rho;
+
+	for (int j = 0; j < this->supportVectors.rows; j++) {
+		const float* sv = this->supportVectors.ptr<float>(j);
+		double s[LINEAR_SVM_LANES] = { 0.0 };
+		int k = 0;
+		// the same order of operations as linear kernel of ml::SVM
+		for (; k <= this->varCount - 4; k += 4) {
+			const float* x0 = x + (size_t)k * LINEAR_SVM_LANES;
+#pragma omp simd
+			for (int l = 0; l < LINEAR_SVM_LANES; l++) {
+				s[l] += sv[k] * x0[l] + sv[k + 1] * x0[l + LINEAR_SVM_LANES] +
+					sv[k + 2] * x0[l + 2 * LINEAR_SVM_LANES] + sv[k + 3] * x0[l + 3 * LINEAR_SVM_LANES];
+			}
+		}
+		for (; k < this->varCount; k++) {
+			const float* x0 = x + (size_t)k * LINEAR_SVM_LANES;
+#pragma omp simd
+			for (int l = 0; l < LINEAR_SVM_LANES; l++)
+				s[l] += sv[k] * x0[l];
+		}
+
+		// kernel value is stored as float in ml::SVM
+		for (int l = 0; l < LINEAR_SVM_LANES; l++)
+			sum[l] += alpha[j] * (double)(float)s[l];
+	}
+
+	for (int l = 0; l < count; l++)
+		scores[l] = (float)sum[l];
+}
+
+
+/**
+ * Getter function for state of scorer
+ */
+bool LinearSvmScorer::isValid() const {
+	return this->valid;
+}
+
+/**
+ * Getter function for length of feature vector
+ */
+int LinearSvmScorer::getVarCount() const {
+	return this->varCount;
+}
@@ -0,0 +1,102 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: LinearSvmScorer.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __LINEARSVMSCORER_H__
+#define __LINEARSVMSCORER_H__
+
+#include <vector>
+#include <algorithm>
+#include <string>
+#include <memory>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <opencv2/opencv.hpp>
+#include <opencv2/core.hpp>
+#include <opencv2/ml.hpp>
+#include "boost/interprocess/file_mapping.hpp"
+#include "boost/interprocess/mapped_region.hpp"
+#include "RandomGenerator.h"
+
+using namespace std;
+
+/* number of feature vectors scored at once (one vector per SIMD lane) */
+const int LINEAR_SVM_LANES = 8;
+
+/* maximal length of feature vector (transposed block of vectors is kept on stack) */
+const int LINEAR_SVM_MAX_VARS = 256;
+
+/* identification of binary model file and version of its format */
+const char LINEAR_SVM_FILE_MAGIC[8] = { 'A', 'C', 'S', 'V', 'M', 'B', 'I', 'N' };
+const uint32_t LINEAR_SVM_FILE_VERSION = 1;
+
+
+/**
+ * Header of binary model file (32 bytes, native byte order). Header is followed by svCount weights (double)
+ * and svCount support vectors (varCount floats each), so all values are aligned and file can be mapped to memory
+ * and used without parsing or copying.
+ */
+struct LinearSvmFileHeader
+{
+	char magic[8];		// LINEAR_SVM_FILE_MAGIC
+	uint32_t version;	// LINEAR_SVM_FILE_VERSION
+	int32_t varCount;	// length of feature vector
+	int32_t svCount;	// number of support vectors
+	uint32_t reserved;	// zero
+	double rho;			// bias of decision function
+};
+
+
+/**
+ * Fast evaluation of trained two-class SVM with linear kernel (RAW_OUTPUT of ml::SVM::predict without its overhead).
+ * Support vectors, weights and bias are extracted from model once, feature vectors are then scored in blocks,
+ * each vector in its own SIMD lane. Arithmetic is the same as in OpenCV (float products summed by four into
+ * double, kernel value rounded to float, weighted sum of kernels minus rho), so the scores are identical.
+ * Extracted model is compared with predict on probe vectors, any other model is left to predict.
+ * Decision function can be also saved to compact binary file, that is loaded by mapping file to memory
+ * (no parsing of .yml file), or set from values compiled into application.
+ */
+class LinearSvmScorer
+{
+public:
+	// constructor (empty scorer)
+	LinearSvmScorer();
+	// extracts linear decision function from model, returns false if model cannot be scored by this class
+	bool extract(const cv::Ptr<cv::ml::SVM>& svm);
+	// sets decision function from arrays (values are not copied, they must exist while scorer is used)
+	bool set(int varCount, int svCount, double rho, const double* alpha, const float* supportVectors);
+	// methods for binary model file
+	bool load(const std::string& filepath);
+	bool save(const std::string& filepath) const;
+	bool isValid() const;
+	int getVarCount() const;
+	// scores all rows of CV_32F matrix (varCount columns)
+	void score(const cv::Mat& feats, float* scores) const;
+	// scores one feature vector
+	float score(const float* feat) const;
+
+private:
+	// true if decision function was extracted
+	bool valid;
+	// length of feature vector
+	int varCount;
+	// bias of decision function
+	double rho;
+	// support vectors of decision function (one per row, CV_32F)
+	cv::Mat supportVectors;
+	// weights of support vectors (1 row, CV_64F)
+	cv::Mat alpha;
+	// binary model file mapped to memory (matrices point into it)
+	std::shared_ptr<boost::interprocess::mapped_region> mapping;
+
+	// scores up to LINEAR_SVM_LANES vectors (rows of feature matrix)
+	void scoreBlock(const float* const* rows, int count, float* scores) const;
+};
+
+#endif //__LINEARSVMSCORER_H__
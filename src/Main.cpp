@@ -25,6 +25,9 @@ using namespace cv;
 
 /* prototypes of functions */
 void showImageAuto(std::string title, const Mat& img);
+std::string targetSuffix(const CropTarget& target, size_t targetsCount);
+void saveTopCandidates(const Mat& img, const std::vector<cv::Rect>& rois, std::string name);
+void showScoreMap(std::string title, const Mat& scoreMap);
 
 /* constant for help message */
 const char* HELP_MESSAGE = 
@@ -40,9 +43,19 @@ const char* HELP_MESSAGE =
 " $ ./autocrop imagePath -wh 600 400  => Defines width and height of final crop(in pixels).\n"
 " $ ./autocrop imagePath -scale 0.5  => Scales down original image to final crop(keeps aspect ratio).\n"
 " $ ./autocrop imagePath -whratio 16 9  => Defines aspect ratio of final crop(width:height).\n"
+" $ ./autocrop imagePath -whratio 1 1 -whratio 16 9 -wh 600 400  => Makes more crops from one saliency map(one crop per -wh/-scale/-whratio).\n"
 " $ ./autocrop imagePath -suh -threshold 0.5  => Defines threshold used in Suh's algorithm.\n"
+" $ ./autocrop imagePath -suh -frontier  => Uses frontier of saliency vs. area saved next to image(imagePath.frontier.yml) for any threshold.\n"
+" $ ./autocrop imagePath -sten -shifted  => Generates Stentiford's saliency map faster with the same forks for all pixels(at 800px instead of 400px).\n"
 " $ ./autocrop imagePath -w  => Disables showing windows of saliency maps and gradient.\n"
-" $ ./autocrop -train datasetPath  => Runs training of Visual Composition model. datasetPath is path to directory with images.\n\n"
+" $ ./autocrop imagePath -sten -search exact  => Selects search mode(default, exact, pyramid, dense, importance).\n"
+" $ ./autocrop imagePath -search importance -samples 1000  => Defines number of generated windows(sample budget) of random methods.\n"
+" $ ./autocrop imagePath -seed 42  => Defines seed for random generators(the same seed gives the same crops).\n"
+" $ ./autocrop imagePath -topk 5  => Saves 5 best distinct crops(cropSuh.jpg, cropSuh_top2.jpg, ...).\n"
+" $ ./autocrop imagePath -fang -refine 4  => Locally refines position and size of 4 best candidates in Fang's algorithm.\n"
+" $ ./autocrop imagePath -fang -model models/Trained_model21.bin  => Loads trained Visual Composition model(.yml or binary file) instead of compiled one.\n"
+" $ ./autocrop -train datasetPath  => Runs training of Visual Composition model. datasetPath is path to directory with images.\n"
+" $ ./autocrop -convert modelPath.yml modelPath.bin  => Converts trained Visual Composition model(linear SVM) to binary file.\n\n"
 "xambro15@stud.fit.vutbr.cz, VUT FIT 2018\n"
 "-----------------------------------------------------------------------------------";
 
@@ -63,9 +76,17 @@ int main(int argc, char** argv)
 	// run training pipeline for creating model of Visual composition
 	if (arguments.runTraining) {
 		CompositionModel comp;
+		if (arguments.isSeed())
+			comp.setSeed(arguments.getSeed());
 		comp.fullTrainingPipeline(arguments.trainingDatasetPath, "./models/Trained_model.yml");
 		std::exit(EXIT_SUCCESS);
 	}
+	// convert trained model of Visual composition to binary file
+	if (arguments.runConversion) {
+		CompositionModel comp;
+		comp.convertTrainedModel(arguments.conversionSrcPath, arguments.conversionDstPath);
+		std::exit(EXIT_SUCCESS);
+	}
 
 
 	// load original Image
@@ -84,6 +105,9 @@ int main(int argc, char** argv)
 	// show original image
 	showImageAuto("original", img);
 
+	// list of requested crops, saliency map and its tables are computed only once for all of them
+	const std::vector<CropTarget> targets = arguments.getTargets();
+
 	// if no method was specified in argument, make all of them one by one
 	if (!arguments.isSuh() && !arguments.isStentiford() && !arguments.isFang()) {
 		arguments.setSuh();
@@ -104,29 +128,61 @@ int main(int argc, char** argv)
 		// automatic cropping methods
 		std::cout << "\nLooking for the best cropping window..." << std::endl;
 		AutocropSuh suh(itti.salMap);
+		if (arguments.isSeed())
+			suh.setSeed(arguments.getSeed());
+		suh.setTopK(arguments.getTopK());
 
 		// use default threshold or threshold specified in arguments
 		const float THRESHOLD = 0.6f;
 		float tr = (arguments.isThreshold()) ? arguments.getThreshold() : THRESHOLD;
 
-		if (arguments.isWH())
-			suh.bruteForceWH(arguments.getWidth(), arguments.getHeight(), HSTEP, VSTEP);
-		else if (arguments.isScale())
-			suh.bruteForceScale(arguments.getScale(), HSTEP, VSTEP);
-		else if (arguments.isWHratio())
-			suh.bruteForceWHratio(arguments.getWidthRatio(), arguments.getHeightRatio(), tr, HSTEP, VSTEP);
-		else
-			suh.greedyGeneral(tr);
-			//suh.bruteForceGeneral(tr);
-
-		// define region of interest for cropping
-		cv::Rect roi(suh.getX(), suh.getY(), suh.getWidth(), suh.getHeight());
-		// crop the original image to the defined roi
-		cv::Mat cropSuh = img(roi);
-		// show cropped result in window
-		showImageAuto("SuhAutocrop", cropSuh);
-		// save cropped image
-		cv::imwrite("cropSuh.jpg", cropSuh);
+		for (size_t t = 0; t < targets.size(); t++) {
+			const CropTarget& target = targets[t];
+			suh.reset();
+
+			if (target.type == TARGET_WH && arguments.getSearchMode() == SEARCH_PYRAMID)
+				suh.pyramidWH(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_WH && arguments.getSearchMode() == SEARCH_DENSE)
+				suh.denseWH(target.width, target.height);
+			else if (target.type == TARGET_WH)
+				suh.bruteForceWH(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE && arguments.getSearchMode() == SEARCH_PYRAMID)
+				suh.pyramidScale(target.scale, HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE && arguments.getSearchMode() == SEARCH_DENSE)
+				suh.denseScale(target.scale);
+			else if (target.type == TARGET_SCALE)
+				suh.bruteForceScale(target.scale, HSTEP, VSTEP);
+			else if (target.type == TARGET_WHRATIO)
+				suh.bruteForceWHratio(target.width, target.height, tr, HSTEP, VSTEP);
+			else if (arguments.isFrontier()) {
+				// frontier is computed only once for image, then any threshold is only lookup
+				std::string frontierPath = arguments.imgPath + ".frontier.yml";
+				if (!suh.loadFrontier(frontierPath, HSTEP, VSTEP)) {
+					suh.computeFrontier(HSTEP, VSTEP);
+					suh.saveFrontier(frontierPath);
+				}
+				if (!suh.frontierByThreshold(tr))
+					std::cerr << "ROI with threshold " << tr << " was not found in frontier." << std::endl;
+			}
+			else if (arguments.getSearchMode() == SEARCH_EXACT)
+				suh.exactGeneral(tr, HSTEP, VSTEP); // the smallest ROI that satisfies threshold (grid gives bound of exact pass)
+			else
+				suh.greedyGeneral(tr);
+				//suh.bruteForceGeneral(tr);
+
+			if (arguments.isWindowsEnabled() && !suh.getScoreMap().empty())	// show map of scores of all positions (only dense crops)
+				showScoreMap("SuhScoreMap" + targetSuffix(target, targets.size()), suh.getScoreMap());
+
+			// define region of interest for cropping
+			cv::Rect roi(suh.getX(), suh.getY(), suh.getWidth(), suh.getHeight());
+			// crop the original image to the defined roi
+			cv::Mat cropSuh = img(roi);
+			// show cropped result in window
+			showImageAuto("SuhAutocrop" + targetSuffix(target, targets.size()), cropSuh);
+			// save cropped image
+			cv::imwrite("cropSuh" + targetSuffix(target, targets.size()) + ".jpg", cropSuh);
+			saveTopCandidates(img, suh.getTopCandidates(), "cropSuh" + targetSuffix(target, targets.size()));
+		}
 	}
 
 	/***************************************************/
@@ -134,8 +190,13 @@ int main(int argc, char** argv)
 	if (arguments.isStentiford()) {
 		// generate saliency map(Stentiford, F.: Attention-based auto image cropping, 2007)
 		SalMapStentiford StentifordSM(img);
+		if (arguments.isSeed())
+			StentifordSM.setSeed(arguments.getSeed());
 		std::cout << "\nGenerating saliency map by Stentiford..." << std::endl;
-		StentifordSM.generateSalMap();
+		if (arguments.isShifted())
+			StentifordSM.generateSalMapShifted();
+		else
+			StentifordSM.generateSalMap();
 		
 		if (arguments.isWindowsEnabled()) {
 			showImageAuto("StentifordSalMap", StentifordSM.salMap);
@@ -144,29 +205,55 @@ int main(int argc, char** argv)
 		// automatic cropping methods
 		std::cout << "\nLooking for the best cropping window..." << std::endl;
 		AutocropStentiford abStentiford(StentifordSM.salMap);
+		if (arguments.isSeed())
+			abStentiford.setSeed(arguments.getSeed());
+		abStentiford.setTopK(arguments.getTopK());
 
 		// value used to define minimum size for ROI in methods with random generator
 		const float DEFAULT_ZOOM_FACTOR = 1.5f; 
 
-		if (arguments.isWH())
-			abStentiford.brutalForceWH(arguments.getWidth(), arguments.getHeight(), HSTEP, VSTEP);
-		else if (arguments.isScale())
-			abStentiford.brutalForceZoomFactor((1.0f / arguments.getScale()), HSTEP, VSTEP);
-		else if (arguments.isWHratio())
-			abStentiford.randomWHratio(arguments.getWidthRatio(), arguments.getHeightRatio(), DEFAULT_ZOOM_FACTOR);
-		else 
-			abStentiford.randomZFWalk(DEFAULT_ZOOM_FACTOR); // using fast method with defined number of generated ROIs
-		//abStentiford.zoomFactorWalk(1.5, 2.0, 0.1, HSTEP, VSTEP);
-		//abStentiford.randomWalk(600, 600);
-		
-		// define region of interest for cropping
-		cv::Rect roi(abStentiford.getX(), abStentiford.getY(), abStentiford.getWidth(), abStentiford.getHeight());
-		// crop the original image to the defined roi
-		cv::Mat cropStentiford = img(roi);
-		// show cropped result in window
-		showImageAuto("StentifordAutocrop", cropStentiford);
-		// save cropped image
-		cv::imwrite("cropStentiford.jpg", cropStentiford);
+		for (size_t t = 0; t < targets.size(); t++) {
+			const CropTarget& target = targets[t];
+			abStentiford.reset();
+
+			if (target.type == TARGET_WH && arguments.getSearchMode() == SEARCH_PYRAMID)
+				abStentiford.pyramidWH(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_WH && arguments.getSearchMode() == SEARCH_DENSE)
+				abStentiford.denseWH(target.width, target.height);
+			else if (target.type == TARGET_WH)
+				abStentiford.brutalForceWH(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE && arguments.getSearchMode() == SEARCH_PYRAMID)
+				abStentiford.pyramidZoomFactor((1.0f / target.scale), HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE && arguments.getSearchMode() == SEARCH_DENSE)
+				abStentiford.denseZoomFactor((1.0f / target.scale));
+			else if (target.type == TARGET_SCALE)
+				abStentiford.brutalForceZoomFactor((1.0f / target.scale), HSTEP, VSTEP);
+			else if (target.type == TARGET_WHRATIO && arguments.getSearchMode() == SEARCH_IMPORTANCE) // ROIs are drawn according to saliency map
+				abStentiford.importanceWHratio(target.width, target.height, DEFAULT_ZOOM_FACTOR, (arguments.getSamples() > 0) ? arguments.getSamples() : ITERATIONS);
+			else if (target.type == TARGET_WHRATIO)
+				abStentiford.randomWHratio(target.width, target.height, DEFAULT_ZOOM_FACTOR);
+			else if (arguments.getSearchMode() == SEARCH_EXACT)
+				abStentiford.branchAndBoundZF(DEFAULT_ZOOM_FACTOR); // provably the best ROI using branch-and-bound search
+			else if (arguments.getSearchMode() == SEARCH_IMPORTANCE) // ROIs are drawn according to saliency map
+				abStentiford.importanceZFWalk(DEFAULT_ZOOM_FACTOR, (arguments.getSamples() > 0) ? arguments.getSamples() : ITERATIONS);
+			else 
+				abStentiford.randomZFWalk(DEFAULT_ZOOM_FACTOR); // using fast method with defined number of generated ROIs
+			//abStentiford.zoomFactorWalk(1.5, 2.0, 0.1, HSTEP, VSTEP);
+			//abStentiford.randomWalk(600, 600);
+			
+			if (arguments.isWindowsEnabled() && !abStentiford.getScoreMap().empty())	// show map of scores of all positions (only dense crops)
+				showScoreMap("StentifordScoreMap" + targetSuffix(target, targets.size()), abStentiford.getScoreMap());
+
+			// define region of interest for cropping
+			cv::Rect roi(abStentiford.getX(), abStentiford.getY(), abStentiford.getWidth(), abStentiford.getHeight());
+			// crop the original image to the defined roi
+			cv::Mat cropStentiford = img(roi);
+			// show cropped result in window
+			showImageAuto("StentifordAutocrop" + targetSuffix(target, targets.size()), cropStentiford);
+			// save cropped image
+			cv::imwrite("cropStentiford" + targetSuffix(target, targets.size()) + ".jpg", cropStentiford);
+			saveTopCandidates(img, abStentiford.getTopCandidates(), "cropStentiford" + targetSuffix(target, targets.size()));
+		}
 	}
 
 	/***************************************************/
@@ -181,30 +268,53 @@ int main(int argc, char** argv)
 		}
 
 		// automatic cropping methods
-		AutocropFang fang(img, MargolinSM.salMap, "./models/Trained_model21.yml");
+		AutocropFang fang(img, MargolinSM.salMap, arguments.getModelPath());
+		if (arguments.isSeed())
+			fang.setSeed(arguments.getSeed());
+		fang.setTopK(arguments.getTopK());
+		fang.setRefine(arguments.getRefine());
 		
 		if (arguments.isWindowsEnabled()) {	// show gradient map
 			showImageAuto("ImageGradient", fang.gradient);
 		}
 		
 		std::cout << "\nLooking for the best cropping window..." << std::endl;
-		if (arguments.isWH())
-			fang.WHCrop(arguments.getWidth(), arguments.getHeight(), HSTEP, VSTEP);
-		else if (arguments.isScale())
-			fang.scaleCrop(arguments.getScale(), HSTEP, VSTEP);
-		else if (arguments.isWHratio())
-			fang.WHratioCrop(arguments.getWidthRatio(), arguments.getHeightRatio(), HSTEP, VSTEP);
-		else
-			fang.randomGridCrop();
-
-		// Define region of interest for cropping
-		cv::Rect roi2(fang.getX(), fang.getY(), fang.getWidth(), fang.getHeight());
-		// Crop the original image to the defined roi
-		cv::Mat cropFang = img(roi2);
-		// Show cropped result in window
-		showImageAuto("FangAutocrop", cropFang);
-		// save cropped image
-		cv::imwrite("cropFang.jpg", cropFang);
+		for (size_t t = 0; t < targets.size(); t++) {
+			const CropTarget& target = targets[t];
+			fang.reset();
+
+			if (target.type == TARGET_WH && arguments.getSearchMode() == SEARCH_PYRAMID)
+				fang.pyramidWHCrop(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_WH && arguments.getSearchMode() == SEARCH_DENSE)
+				fang.denseWHCrop(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_WH)
+				fang.WHCrop(target.width, target.height, HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE && arguments.getSearchMode() == SEARCH_PYRAMID)
+				fang.pyramidScaleCrop(target.scale, HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE && arguments.getSearchMode() == SEARCH_DENSE)
+				fang.denseScaleCrop(target.scale, HSTEP, VSTEP);
+			else if (target.type == TARGET_SCALE)
+				fang.scaleCrop(target.scale, HSTEP, VSTEP);
+			else if (target.type == TARGET_WHRATIO)
+				fang.WHratioCrop(target.width, target.height, HSTEP, VSTEP);
+			else if (arguments.getSearchMode() == SEARCH_IMPORTANCE) // ROIs are drawn according to saliency map
+				fang.importanceCrop((arguments.getSamples() > 0) ? arguments.getSamples() : IMPORTANCE_SAMPLES_FANG);
+			else
+				fang.randomGridCrop();
+
+			if (arguments.isWindowsEnabled() && !fang.getScoreMap().empty())	// show map of scores of all positions (only dense crops)
+				showScoreMap("FangScoreMap" + targetSuffix(target, targets.size()), fang.getScoreMap());
+
+			// Define region of interest for cropping
+			cv::Rect roi2(fang.getX(), fang.getY(), fang.getWidth(), fang.getHeight());
+			// Crop the original image to the defined roi
+			cv::Mat cropFang = img(roi2);
+			// Show cropped result in window
+			showImageAuto("FangAutocrop" + targetSuffix(target, targets.size()), cropFang);
+			// save cropped image
+			cv::imwrite("cropFang" + targetSuffix(target, targets.size()) + ".jpg", cropFang);
+			saveTopCandidates(img, fang.getTopCandidates(), "cropFang" + targetSuffix(target, targets.size()));
+		}
 	}
 
 	return 0;
@@ -233,4 +343,48 @@ void showImageAuto(std::string title, const Mat &img)
 		cv::imshow(title, scaled);
 	}
 	cv::waitKey(0);
+}
+
+
+/**
+ * Function for creating suffix of output file and window names of one requested crop
+ * @param target Requested crop
+ * @param targetsCount Number of all requested crops
+ * @return Empty string for single crop (names are the same as before, e.g. cropSuh.jpg), else label of crop (e.g. _wh600x400)
+ */
+std::string targetSuffix(const CropTarget& target, size_t targetsCount)
+{
+	if (targetsCount < 2 || target.label.empty())
+		return "";
+	return "_" + target.label;
+}
+
+
+/**
+ * Function for saving other distinct crops (the first crop is final crop that is already saved)
+ * @param img Original image
+ * @param rois The best distinct crops from the best one
+ * @param name Name of final crop without extension (other crops are saved as name_top2.jpg, name_top3.jpg, ...)
+ */
+void saveTopCandidates(const Mat& img, const std::vector<cv::Rect>& rois, std::string name)
+{
+	for (size_t i = 1; i < rois.size(); i++)
+		cv::imwrite(name + "_top" + std::to_string(i + 1) + ".jpg", img(rois[i]));
+}
+
+
+/**
+ * Function for showing map of scores of all positions as heatmap (nothing is shown for empty map)
+ * @param title Name of the window
+ * @param scoreMap Map of scores CV_64F
+ */
+void showScoreMap(std::string title, const Mat& scoreMap)
+{
+	if (scoreMap.empty())
+		return;
+
+	cv::Mat normalized, heatmap;
+	cv::normalize(scoreMap, normalized, 0, 255, NORM_MINMAX, CV_8UC1);
+	cv::applyColorMap(normalized, heatmap, cv::COLORMAP_JET);
+	showImageAuto(title, heatmap);
 }
\ No newline at end of file
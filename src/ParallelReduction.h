@@ -0,0 +1,65 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: ParallelReduction.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __PARALLELREDUCTION_H__
+#define __PARALLELREDUCTION_H__
+
+#include <cfloat>
+
+
+/**
+ * Candidate cropping window with its score.
+ * Windows are compared with fixed tie-break, so the best window does not depend on order of evaluation
+ * (higher score, then smaller y, smaller x, smaller width and smaller height).
+ */
+struct ScoredWindow
+{
+	double score;
+	int x;
+	int y;
+	int width;
+	int height;
+
+	// default window is invalid and worse than any evaluated window
+	ScoredWindow() : score(-DBL_MAX), x(0), y(0), width(0), height(0) {}
+	ScoredWindow(double s, int x1, int y1, int w, int h) : score(s), x(x1), y(y1), width(w), height(h) {}
+
+	// returns true if this window was evaluated
+	bool isValid() const {
+		return this->width > 0 && this->height > 0;
+	}
+
+	// strict total order of windows
+	bool isBetterThan(const ScoredWindow& other) const {
+		if (this->score != other.score) return this->score > other.score;
+		if (this->y != other.y) return this->y < other.y;
+		if (this->x != other.x) return this->x < other.x;
+		if (this->width != other.width) return this->width < other.width;
+		return this->height < other.height;
+	}
+
+	// keep better of this window and candidate
+	void update(const ScoredWindow& candidate) {
+		if (candidate.isBetterThan(*this))
+			*this = candidate;
+	}
+};
+
+
+/**
+ * Parallel argmax of ScoredWindow for OpenMP loops:
+ *   ScoredWindow best;
+ *   #pragma omp parallel for reduction(bestWindow : best)
+ * Each thread keeps its own best window on its stack(no shared writes => no races and no false sharing)
+ * and private results are merged at the end. Thanks to total order of windows the result is identical
+ * for any number of threads.
+ */
+#pragma omp declare reduction(bestWindow : ScoredWindow : omp_out.update(omp_in)) initializer(omp_priv = ScoredWindow())
+
+#endif //__PARALLELREDUCTION_H__
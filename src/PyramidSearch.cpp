@@ -0,0 +1,109 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: PyramidSearch.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "PyramidSearch.h"
+
+/**
+ * Constructor
+ * @param integral Summed-area table of saliency map
+ */
+PyramidSearch::PyramidSearch(const SaliencyIntegral& integral) : integral(integral) {
+}
+
+
+/**
+ * Method for finding the best ROIs with defined width and height from coarse to fine level
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @param hStep Horizontal step of grid (the coarsest level uses PYRAMID_COARSE_FACTOR times larger step)
+ * @param vStep Vertical step of grid (the coarsest level uses PYRAMID_COARSE_FACTOR times larger step)
+ * @param topK Number of the best windows (seeds) that are refined at each level
+ * @return The best windows found at the finest level (step 1px), sorted from the best one
+ */
+std::vector<ScoredWindow> PyramidSearch::searchWH(int w, int h, int hStep, int vStep, int topK) {
+	std::vector<ScoredWindow> seeds;
+
+	// parameter conditions
+	if (w <= 0 || h <= 0 || w > this->integral.getWidth() || h > this->integral.getHeight() || hStep < 1 || vStep < 1 || topK < 1)
+		return seeds;
+
+	// last possible position of top left corner
+	const int maxX = this->integral.getWidth() - w;
+	const int maxY = this->integral.getHeight() - h;
+
+	/* the coarsest level - walk through grid with coarse step */
+	int prevH = hStep * PYRAMID_COARSE_FACTOR;
+	int prevV = vStep * PYRAMID_COARSE_FACTOR;
+	const int gridCols = maxX / prevH + 1;
+	const int gridRows = maxY / prevV + 1;
+	seeds.resize((size_t)gridCols * gridRows);
+
+#pragma omp parallel for
+	for (int j = 0; j < gridRows; j++) {
+		for (int i = 0; i < gridCols; i++) {
+			int xx = i * prevH;
+			int yy = j * prevV;
+			seeds[(size_t)j * gridCols + i] = ScoredWindow((double)this->integral.sum(xx, yy, w, h), xx, yy, w, h);
+		}
+	}
+	this->selectTopK(seeds, topK);
+
+	/* finer levels - each seed moves to the best position of its neighbourhood with halved step */
+	while (prevH > 1 || prevV > 1) {
+		int stepH = std::max(1, prevH / 2);
+		int stepV = std::max(1, prevV / 2);
+
+		// neighbourhood of seed is +-prevStep (rounded up to multiple of new step, so the seed itself is included)
+		const int kH = (prevH + stepH - 1) / stepH;
+		const int kV = (prevV + stepV - 1) / stepV;
+
+#pragma omp parallel for
+		for (int s = 0; s < (int)seeds.size(); s++) {
+			ScoredWindow best = seeds[s];
+			for (int dy = -kV; dy <= kV; dy++) {
+				for (int dx = -kH; dx <= kH; dx++) {
+					int xx = seeds[s].x + dx * stepH;
+					int yy = seeds[s].y + dy * stepV;
+					// positions out of image are skipped
+					if (xx >= 0 && yy >= 0 && xx <= maxX && yy <= maxY)
+						best.update(ScoredWindow((double)this->integral.sum(xx, yy, w, h), xx, yy, w, h));
+				}
+			}
+			seeds[s] = best;
+		}
+
+		// seeds that moved to the same position are merged
+		this->selectTopK(seeds, topK);
+		prevH = stepH;
+		prevV = stepV;
+	}
+
+	return seeds;
+}
+
+
+/**
+ * Method that sorts windows from the best one and keeps only topK distinct windows
+ * @param windows Vector of windows (modified in place)
+ * @param topK Number of windows to keep
+ */
+void PyramidSearch::selectTopK(std::vector<ScoredWindow>& windows, int topK) {
+	// remove invalid windows and duplicates (the same window can be found from more seeds)
+	std::sort(windows.begin(), windows.end(), [](const ScoredWindow& a, const ScoredWindow& b) {
+		return a.isBetterThan(b);
+	});
+	windows.erase(std::unique(windows.begin(), windows.end(), [](const ScoredWindow& a, const ScoredWindow& b) {
+		return a.x == b.x && a.y == b.y && a.width == b.width && a.height == b.height;
+	}), windows.end());
+	while (!windows.empty() && !windows.back().isValid())
+		windows.pop_back();
+
+	if ((int)windows.size() > topK)
+		windows.resize(topK);
+}
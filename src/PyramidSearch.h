@@ -0,0 +1,49 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: PyramidSearch.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __PYRAMIDSEARCH_H__
+#define __PYRAMIDSEARCH_H__
+
+#include <vector>
+#include <algorithm>
+#include "SaliencyIntegral.h"
+#include "ParallelReduction.h"
+
+using namespace std;
+
+/* default number of the best windows (seeds) that are refined at each level */
+const int PYRAMID_TOP_K = 8;
+/* step of the coarsest level = PYRAMID_COARSE_FACTOR * step of grid */
+const int PYRAMID_COARSE_FACTOR = 4;
+
+
+/**
+ * Coarse-to-fine(multiresolution) search for ROI with fixed width and height.
+ * The first level walks through grid with step PYRAMID_COARSE_FACTOR times larger than step of grid, the top-k windows are seeds.
+ * At every next level the step is halved and each seed moves to the best position of its neighbourhood, until step is 1px.
+ * Only neighbourhoods of seeds are walked through, so the finer levels cost O(k) and seeds stay in distinct parts of image.
+ * Windows are evaluated by summed-area table, so window sums at step s are the same values as sums
+ * in saliency pyramid downsampled s times (no pyramid images have to be stored).
+ */
+class PyramidSearch
+{
+public:
+	// constructor
+	PyramidSearch(const SaliencyIntegral& integral);
+	// returns the best windows (sorted from the best one), score of window is its saliency energy
+	std::vector<ScoredWindow> searchWH(int w, int h, int hStep, int vStep, int topK = PYRAMID_TOP_K);
+
+private:
+	// summed-area table of saliency map
+	const SaliencyIntegral& integral;
+	// keeps only topK best distinct windows in vector
+	void selectTopK(std::vector<ScoredWindow>& windows, int topK);
+};
+
+#endif //__PYRAMIDSEARCH_H__
@@ -0,0 +1,106 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: RandomGenerator.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __RANDOMGENERATOR_H__
+#define __RANDOMGENERATOR_H__
+
+#include <cstdint>
+#include <ctime>
+
+
+/**
+ * Domains of random sequences, one for each place where generator is used. Streams are only indexes of iterations,
+ * so without domain different stages with the same seed (e.g. forks of saliency map and random crops)
+ * would replay the same sequences.
+ */
+enum RandomDomain : uint64_t {
+	RANDOM_DOMAIN_STENTIFORD_FORKS = 1,		// forks of Stentiford's saliency map (stream = column)
+	RANDOM_DOMAIN_STENTIFORD_SHIFTED,		// shared forks of Stentiford's shifted saliency map
+	RANDOM_DOMAIN_STENTIFORD_WHRATIO,		// AutocropStentiford::randomWHratio
+	RANDOM_DOMAIN_STENTIFORD_ZF_WALK,		// AutocropStentiford::randomZFWalk
+	RANDOM_DOMAIN_STENTIFORD_WALK,			// AutocropStentiford::randomWalk
+	RANDOM_DOMAIN_STENTIFORD_IMPORTANCE_ZF,	// AutocropStentiford::importanceZFWalk
+	RANDOM_DOMAIN_STENTIFORD_IMPORTANCE_WHRATIO,	// AutocropStentiford::importanceWHratio
+	RANDOM_DOMAIN_SUH_GENERAL,				// AutocropSuh::bruteForceGeneral
+	RANDOM_DOMAIN_FANG_GRID,				// AutocropFang::randomGridCrop
+	RANDOM_DOMAIN_FANG_IMPORTANCE,			// AutocropFang::importanceCrop
+	RANDOM_DOMAIN_TRAINING,					// random crops of training images
+	RANDOM_DOMAIN_SVM_PROBE					// probe vectors of LinearSvmScorer
+};
+
+
+/**
+ * Small and fast pseudo-random generator (xoshiro256**) that replaces rand() in parallel loops.
+ * Generator is defined by seed, domain (place of use) and number of stream (e.g. index of iteration or position in grid),
+ * so every iteration has its own independent sequence. There is no shared state between threads and
+ * results are the same for given seed regardless of number of threads.
+ * (methods are defined in header, because generator is created and used in the most inner loops)
+ */
+class RandomGenerator
+{
+public:
+	// constructor
+	RandomGenerator(uint64_t seed, RandomDomain domain, uint64_t stream = 0) {
+		// domain is hashed to salt, so sequences of different domains are independent for the same seed and stream
+		uint64_t domainState = (uint64_t)domain;
+		const uint64_t salt = splitMix64(domainState);
+		// state is initialized with SplitMix64 sequence of seed, domain and stream
+		uint64_t sm = seed ^ salt ^ (stream * 0xD1342543DE82EF95ULL);
+		for (int i = 0; i < 4; i++)
+			this->state[i] = splitMix64(sm);
+	}
+
+	// next 64-bit random number
+	uint64_t next() {
+		const uint64_t result = rotl(this->state[1] * 5, 7) * 9;
+		const uint64_t t = this->state[1] << 17;
+
+		this->state[2] ^= this->state[0];
+		this->state[3] ^= this->state[1];
+		this->state[1] ^= this->state[2];
+		this->state[0] ^= this->state[3];
+		this->state[2] ^= t;
+		this->state[3] = rotl(this->state[3], 45);
+
+		return result;
+	}
+
+	// random integer in range [0,n) - replacement of rand() % n (returns 0 for n <= 0)
+	int uniform(int n) {
+		if (n <= 0)
+			return 0;
+		return (int)(((this->next() >> 32) * (uint64_t)n) >> 32);
+	}
+
+	// random real number in range [0,1)
+	double uniformReal() {
+		return (double)(this->next() >> 11) * (1.0 / 9007199254740992.0);
+	}
+
+	// seed that is used when no seed was defined (the same as srand(time(NULL)) before)
+	static uint64_t timeSeed() {
+		return (uint64_t)time(NULL);
+	}
+
+private:
+	uint64_t state[4];
+
+	static uint64_t rotl(uint64_t x, int k) {
+		return (x << k) | (x >> (64 - k));
+	}
+
+	static uint64_t splitMix64(uint64_t& x) {
+		uint64_t z = (x += 0x9E3779B97F4A7C15ULL);
+		z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+		z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+		return z ^ (z >> 31);
+	}
+};
+
+#endif //__RANDOMGENERATOR_H__
@@ -19,54 +19,60 @@ SalMapStentiford::SalMapStentiford(cv::Mat img) {
 
 	this->hTranslation = (TRANSLATION_DIVIDER != 0) ? (int)(img.cols / TRANSLATION_DIVIDER) : img.cols;
 	this->vTranslation = (TRANSLATION_DIVIDER != 0) ? (int)(img.rows / TRANSLATION_DIVIDER) : img.rows;
+	// random generators are initialized with actual time, if seed is not defined
+	this->seed = RandomGenerator::timeSeed();
+}
+
+
+/**
+ * Setter function for seed of random generators
+ * @param seed Seed value (the same seed gives the same saliency map)
+ */
+void SalMapStentiford::setSeed(uint64_t seed) {
+	this->seed = seed;
 }
 
 
 /**
 * Method for generating saliency map of input image, it is saved to matrix salMap
-* @param m Number of pixels in each fork
+* @param m Number of pixels in each fork (at most MAX_M)
 * @param eps Definiton for neighbourhood of current pixels = max distance of other pixels 
 * @param t Number of generated forks
 * @param treshold Value that defines if fork A mismatches fork B 
 */
 void SalMapStentiford::generateSalMap(int m, int eps, int t, float treshold) {
-	srand((unsigned int)time(NULL));
+	CV_Assert(m >= 1 && m <= MAX_M);
 
 	// big images would be scaled down - max 400px width or height
-	const float maxSize = 400.f;
-	double scale = maxSize / max(this->originalImage.cols, this->originalImage.rows);
-
-	if (scale >= 1.f) {	// dont resize
-		this->image = this->originalImage;
-	}
-	else { // image is large, resize it to max 800px of width or height
-		// use INTER_AREA to resampling using pixel area relation
-		cv::resize(this->originalImage, this->image, Size(), scale, scale, cv::INTER_AREA);
-	}
-
+	const float maxSize = DEFAULT_MAX_SIZE;
+	this->scaleDownImage(maxSize);
 
 	// Mat for saving saliency values each pixel
 	cv::Mat salmap_scaled = Mat(this->image.rows, this->image.cols, CV_8UC1);
+	// distance of pixels is compared without square root
+	const int tresholdSq = this->squaredThreshold(treshold);
 
 	// loop and computation for every single pixel of original image
 #pragma omp parallel for
 	for (int xx = 0; xx < this->image.cols; xx++) {
+		// each column has its own random sequence (no shared state between threads)
+		RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_FORKS, xx);
+		// forks are reused for all pixels of column (no allocations in the inner loops)
+		Fork forkSA;
+		Fork forkSB;
+
 		for (int yy = 0; yy < this->image.rows; yy++) {
 			int pxAttentionScore = 0;
 			bool forkMisMatch = false;
 		
 			for (int i = 0; i < t; i++) {
-				std::vector<std::array<int, 2>> forkSA = this->createForkSA(xx, yy, m, eps);
-				std::vector<std::array<int, 2>> forkSB = this->createForkSB(forkSA, m);
+				this->createForkSA(xx, yy, m, eps, rng, forkSA);
+				this->createForkSB(forkSA, m, rng, forkSB);
 
 				forkMisMatch = false;
 				for (int j = 0; j < m; j++) {
 					// check mismatch of forks
-					if (this->mismatchPixels(std::get<0>(forkSA.at(j)),
-											std::get<1>(forkSA.at(j)),
-											std::get<0>(forkSB.at(j)),
-											std::get<1>(forkSB.at(j)),
-											treshold)) {
+					if (this->mismatchPixels(forkSA[j][0], forkSA[j][1], forkSB[j][0], forkSB[j][1], tresholdSq)) {
 
 						forkMisMatch = true; // mismatch detected -> score will be incremented
 						break;
@@ -88,13 +94,144 @@ void SalMapStentiford::generateSalMap(int m, int eps, int t, float treshold) {
 		}
 	}
 
+	this->scaleBackSalMap(salmap_scaled, maxSize);
+}
+
+
+/**
+* Method for generating saliency map of input image with image-wide forks, it is saved to matrix salMap.
+* Each of t fork patterns (offsets of m pixels in neighbourhood and translation) is drawn once and used for all pixels,
+* so the pattern is evaluated as passes over shifted image rows. For pixel p the fork mismatches if any of its pixels
+* p+o mismatches pixel p+o+d, so mismatch mask of pattern is OR of m shifted copies of one mask |I(x) - I(x+d)| > treshold.
+* Every pixel gets the same distribution of forks as in generateSalMap (neighbourhood is clamped at borders instead
+* of clipped), so the expected attention score is the same, but forks of neighbouring pixels are correlated.
+* @param m Number of pixels in each fork (at most MAX_M)
+* @param eps Definiton for neighbourhood of current pixels = max distance of other pixels
+* @param t Number of generated forks
+* @param treshold Value that defines if fork A mismatches fork B
+* @param maxSize Max width or height of image used for computation (larger images are scaled down)
+*/
+void SalMapStentiford::generateSalMapShifted(int m, int eps, int t, float treshold, float maxSize) {
+	CV_Assert(m >= 1 && m <= MAX_M && this->originalImage.channels() == 3);
+
+	// fork patterns are drawn from one random sequence before evaluation
+	RandomGenerator rng(this->seed, RANDOM_DOMAIN_STENTIFORD_SHIFTED);
+	std::vector<ForkPattern> patterns(t);
+	for (int i = 0; i < t; i++) {
+		for (int j = 0; j < m; j++) {
+			patterns[i].offsets[j][0] = rng.uniform(2 * eps + 1) - eps;
+			patterns[i].offsets[j][1] = rng.uniform(2 * eps + 1) - eps;
+		}
+		// translation is generated the same way as in createForkSB
+		patterns[i].deltaX = 1 + rng.uniform(this->hTranslation);
+		patterns[i].deltaY = 1 + rng.uniform(this->vTranslation);
+		if (rng.uniform(100) < 50) patterns[i].deltaX *= -1;
+		if (rng.uniform(100) < 50) patterns[i].deltaY *= -1;
+	}
+
+	// max value of pixel is 255
+	cv::Mat salmap_scaled;
+	this->countShiftedMismatches(patterns, m, treshold, maxSize).convertTo(salmap_scaled, CV_8UC1);
+
+	this->scaleBackSalMap(salmap_scaled, maxSize);
+}
+
+
+/**
+* Method for counting mismatching forks of each pixel, each fork pattern is evaluated for all pixels by two passes over
+* shifted rows of image (see generateSalMapShifted). Pixel p with pattern (offsets o, translation d) mismatches
+* if |I(c(p+o)) - I(c(c(p+o)+d))| > treshold for any of m offsets, where c clamps position to image.
+* @param patterns Fork patterns (offsets and translation)
+* @param m Number of pixels in each fork (at most MAX_M)
+* @param treshold Value that defines if fork A mismatches fork B
+* @param maxSize Max width or height of image used for computation (larger images are scaled down)
+* @return Number of mismatching forks of each pixel of scaled image (CV_32SC1)
+*/
+cv::Mat SalMapStentiford::countShiftedMismatches(const std::vector<ForkPattern>& patterns, int m, float treshold, float maxSize) {
+	CV_Assert(m >= 1 && m <= MAX_M && this->originalImage.channels() == 3);
+	this->scaleDownImage(maxSize);
+
+	const int cols = this->image.cols;
+	const int rows = this->image.rows;
+	// distance of pixels is compared without square root
+	const int tresholdSq = this->squaredThreshold(treshold);
+	const int t = (int)patterns.size();
+
+	// mismatch mask of actual pattern (0 or 1), mismatch of forks and number of mismatching forks of each pixel
+	cv::Mat mask(rows, cols, CV_8UC1);
+	cv::Mat hits(rows, cols, CV_8UC1);
+	cv::Mat counts = Mat::zeros(rows, cols, CV_32SC1);
+
+	for (int i = 0; i < t; i++) {
+		const ForkPattern& pattern = patterns[i];
+
+		// pass 1: mismatch of every pixel x and its translated pixel x+d
+#pragma omp parallel for
+		for (int yy = 0; yy < rows; yy++) {
+			const uchar* pA = this->image.ptr<uchar>(yy);
+			const uchar* pB = this->image.ptr<uchar>(this->checkMaxMinHeight(yy + pattern.deltaY));
+			uchar* pMask = mask.ptr<uchar>(yy);
+
+			// translated pixels out of image are clamped to the first or the last column
+			int x1 = std::min(cols, std::max(0, -pattern.deltaX));
+			int x2 = std::max(x1, std::min(cols, cols - pattern.deltaX));
+			this->mismatchRow(pA, pB, 0, x1, tresholdSq, pMask);
+			int xB = std::min(cols - 1, std::max(0, x1 + pattern.deltaX));
+			this->mismatchRow(pA + 3 * x1, pB + 3 * xB, 3, x2 - x1, tresholdSq, pMask + x1);
+			this->mismatchRow(pA + 3 * x2, pB + 3 * (cols - 1), 0, cols - x2, tresholdSq, pMask + x2);
+		}
+
+		// pass 2: fork of pixel p mismatches if any of its pixels p+o mismatches
+#pragma omp parallel for
+		for (int yy = 0; yy < rows; yy++) {
+			uchar* hit = hits.ptr<uchar>(yy);
+			std::fill(hit, hit + cols, 0);
+			for (int j = 0; j < m; j++) {
+				const uchar* pMask = mask.ptr<uchar>(this->checkMaxMinHeight(yy + pattern.offsets[j][1]));
+				this->orShiftedRow(pMask, pattern.offsets[j][0], cols, hit);
+			}
+
+			int* pCount = counts.ptr<int>(yy);
+#pragma omp simd
+			for (int xx = 0; xx < cols; xx++)
+				pCount[xx] += hit[xx];
+		}
+	}
+
+	return counts;
+}
+
+
+/**
+* Method for scaling down input image, result is saved to matrix image
+* @param maxSize Max width or height of scaled image
+*/
+void SalMapStentiford::scaleDownImage(float maxSize) {
+	double scale = maxSize / max(this->originalImage.cols, this->originalImage.rows);
+
+	if (scale >= 1.f) {	// dont resize
+		this->image = this->originalImage;
+	}
+	else { // image is large, resize it to max maxSize px of width or height
+		// use INTER_AREA to resampling using pixel area relation
+		cv::resize(this->originalImage, this->image, Size(), scale, scale, cv::INTER_AREA);
+	}
+}
+
+
+/**
+* Method for scaling saliency map back to size of original image and normalizing it, result is saved to matrix salMap
+* @param salmapScaled Saliency map of scaled image
+* @param maxSize Max width or height of scaled image (the same as in scaleDownImage)
+*/
+void SalMapStentiford::scaleBackSalMap(cv::Mat salmapScaled, float maxSize) {
 	// If image has been scaled down, now scale it back
 	if (this->originalImage.cols > (int)maxSize || this->originalImage.rows > (int)maxSize) {
 		// Scale back to original size for further processing
-		cv::resize(salmap_scaled, this->salMap, this->originalImage.size());
+		cv::resize(salmapScaled, this->salMap, this->originalImage.size());
 	}
 	else {  // image has not been scaled down, no need to scale back
-		this->salMap = salmap_scaled;
+		this->salMap = salmapScaled;
 	}
 
 	// normalize it in range [0,255]
@@ -103,56 +240,94 @@ void SalMapStentiford::generateSalMap(int m, int eps, int t, float treshold) {
 
 
 /**
-* Method that detects mismatching between two pixels
+* Method that detects mismatching of row of pixels and row of translated pixels (squared L2 norm as in mismatchPixels)
+* @param pA Pointer to the first pixel of row (3 channels)
+* @param pB Pointer to the first translated pixel
+* @param stepB Step of translated pixels in bytes (3 for row, 0 for the same clamped pixel)
+* @param n Number of pixels
+* @param tresholdSq Squared threshold (see squaredThreshold)
+* @param pMask Output mask (1 for mismatch, else 0)
+*/
+void SalMapStentiford::mismatchRow(const uchar* pA, const uchar* pB, int stepB, int n, int tresholdSq, uchar* pMask) {
+#pragma omp simd
+	for (int x = 0; x < n; x++) {
+		int d0 = pA[3 * x + 0] - pB[stepB * x + 0];
+		int d1 = pA[3 * x + 1] - pB[stepB * x + 1];
+		int d2 = pA[3 * x + 2] - pB[stepB * x + 2];
+		pMask[x] = (d0 * d0 + d1 * d1 + d2 * d2 > tresholdSq) ? 1 : 0;
+	}
+}
+
+
+/**
+* Method for adding horizontally shifted row of mask to output row (logical OR), positions are clamped to row
+* @param pMask Row of mismatch mask
+* @param offset Horizontal offset of fork pixel
+* @param n Number of pixels in row
+* @param hit Output row (hit[x] |= pMask[x + offset])
+*/
+void SalMapStentiford::orShiftedRow(const uchar* pMask, int offset, int n, uchar* hit) {
+	int x1 = std::min(n, std::max(0, -offset));
+	int x2 = std::max(x1, std::min(n, n - offset));
+
+	for (int x = 0; x < x1; x++)
+		hit[x] |= pMask[0];
+#pragma omp simd
+	for (int x = x1; x < x2; x++)
+		hit[x] |= pMask[x + offset];
+	for (int x = x2; x < n; x++)
+		hit[x] |= pMask[n - 1];
+}
+
+
+/**
+* Method that detects mismatching between two pixels (L2 norm of colour difference is greater than threshold)
 * @param x1 Coordination X of first pixel
 * @param y1 Coordination Y of first pixel
 * @param x2 Coordination X of second pixel
 * @param y2 Coordination Y of second pixel
-* @param treshold Value that defines if pixel 1 mismatches pixel 2
+* @param tresholdSq Squared threshold (see squaredThreshold)
 * @return true if mismatching is detected, else returns false
 */
-bool SalMapStentiford::mismatchPixels(int x1, int y1, int x2, int y2, float treshold) {
+bool SalMapStentiford::mismatchPixels(int x1, int y1, int x2, int y2, int tresholdSq) {
 	// number of channels
 	int channels = this->image.channels();
+	const uchar* p1 = this->image.data + channels * (this->image.cols * y1 + x1);
+	const uchar* p2 = this->image.data + channels * (this->image.cols * y2 + x2);
 
-	// L1 norm
-	//double Fxy = abs(this->image.data[channels * (this->image.cols * y1 + x1) + 0] - this->image.data[channels * (this->image.cols * y2 + x2) + 0]) +
-	//	abs(this->image.data[channels * (this->image.cols * y1 + x1) + 1] - this->image.data[channels * (this->image.cols * y2 + x2) + 1]) +
-	//	abs(this->image.data[channels * (this->image.cols * y1 + x1) + 2] - this->image.data[channels * (this->image.cols * y2 + x2) + 2]);
-	
-	// L2 norm
-	double Fxy = sqrt(pow(this->image.data[channels * (this->image.cols * y1 + x1) + 0] - this->image.data[channels * (this->image.cols * y2 + x2) + 0], 2) +
-		pow(this->image.data[channels * (this->image.cols * y1 + x1) + 1] - this->image.data[channels * (this->image.cols * y2 + x2) + 1], 2) +
-		pow(this->image.data[channels * (this->image.cols * y1 + x1) + 2] - this->image.data[channels * (this->image.cols * y2 + x2) + 2], 2));
-
-	// Colour Average
-	/*double F1 = this->image.data[channels * (this->image.cols * y1 + x1) + 0] +
-		this->image.data[channels * (this->image.cols * y1 + x1) + 1] +
-		this->image.data[channels * (this->image.cols * y1 + x1) + 2];
-	F1 /= 3;
-
-	double F2 = this->image.data[channels * (this->image.cols * y2 + x2) + 0] +
-		this->image.data[channels * (this->image.cols * y2 + x2) + 1] +
-		this->image.data[channels * (this->image.cols * y2 + x2) + 2];
-	F2 /= 3;
-
-	double Fxy = abs(F1 - F2);*/
-
-	// empiric grayscale equation
-	// double F1 = 0.11 * this->image.data[channels * (this->image.cols * y1 + x1) + 0] +	// blue
-	// 	0.59 * this->image.data[channels * (this->image.cols * y1 + x1) + 1] +		// green
-	// 	0.3 * this->image.data[channels * (this->image.cols * y1 + x1) + 2];		// red
+	// squared L2 norm in integers
+	int d0 = p1[0] - p2[0];
+	int d1 = p1[1] - p2[1];
+	int d2 = p1[2] - p2[2];
+	int Fxy = d0 * d0 + d1 * d1 + d2 * d2;
 
-	// double F2 = 0.11 * this->image.data[channels * (this->image.cols * y2 + x2) + 0] +	// blue
-	// 	0.59 * this->image.data[channels * (this->image.cols * y2 + x2) + 1] +		// green
-	// 	0.3 * this->image.data[channels * (this->image.cols * y2 + x2) + 2];		// red
-
-	// double Fxy = abs(F1 - F2);
+	return Fxy > tresholdSq;
+}
 
-	if (Fxy > treshold)
-		return true;
 
-	return false;
+/**
+* Method that converts threshold of L2 norm to threshold of squared L2 norm. Squared norm is integer,
+* so the threshold is the largest integer whose square root is not greater than threshold
+* (sqrt(Fxy) > treshold <=> Fxy > tresholdSq, the same result as comparison of norm).
+* @param treshold Value that defines if pixel 1 mismatches pixel 2
+* @return Squared threshold (-1 for negative threshold => every pair of pixels mismatches)
+*/
+int SalMapStentiford::squaredThreshold(float treshold) {
+	// max squared distance of two colours
+	const int maxSq = 3 * 255 * 255;
+	if (treshold < 0.0f)
+		return -1;
+	if (treshold >= std::sqrt((double)maxSq))
+		return maxSq;
+
+	int tresholdSq = (int)((double)treshold * treshold);
+	// correction of rounding
+	while (tresholdSq < maxSq && std::sqrt((double)(tresholdSq + 1)) <= treshold)
+		tresholdSq++;
+	while (tresholdSq >= 0 && std::sqrt((double)tresholdSq) > treshold)
+		tresholdSq--;
+
+	return tresholdSq;
 }
 
 
@@ -162,11 +337,10 @@ bool SalMapStentiford::mismatchPixels(int x1, int y1, int x2, int y2, float tres
 * @param y1 Coordination Y of pixel
 * @param m Number of pixels in fork
 * @param eps Neighbouring distance from pixel
-* @return Vector that represents fork of pixels
+* @param rng Random generator of actual thread
+* @param forkSA Output fork of pixels (first m pixels are set)
 */
-std::vector<std::array<int, 2>> SalMapStentiford::createForkSA(int x1, int y1, int m, int eps) {
-	std::vector<std::array<int, 2>> forkSA;
-
+void SalMapStentiford::createForkSA(int x1, int y1, int m, int eps, RandomGenerator& rng, Fork& forkSA) {
 	// limits for neighbourhood
 	int minX = x1 - eps;
 	int maxX = x1 + eps;
@@ -179,45 +353,35 @@ std::vector<std::array<int, 2>> SalMapStentiford::createForkSA(int x1, int y1, i
 
 	for (int i = 0; i < m; i++) {
 		// generate random coordinates of defined neighbourhood
-		int newX = minX + (rand() % (1 + maxX - minX));
-		int newY = minY + (rand() % (1 + maxY - minY));
-
-		// save coordinates of pixel to forkSA
-		std::array<int, 2> xy = {newX, newY};
-		forkSA.push_back(xy);
+		forkSA[i][0] = minX + rng.uniform(1 + maxX - minX);
+		forkSA[i][1] = minY + rng.uniform(1 + maxY - minY);
 	}
-
-	return forkSA;
 }
 
 
 /**
-* Method that creates fork SB of pixels(translated version of forkSB)
-* @param sa Vector that represents forkSB
+* Method that creates fork SB of pixels(translated version of forkSA)
+* @param sa Fork SA of pixels
 * @param m Number of pixels in fork
-* @return Vector that represents fork SB of pixels
+* @param rng Random generator of actual thread
+* @param forkSB Output fork of pixels (first m pixels are set)
 */
-std::vector<std::array<int, 2>> SalMapStentiford::createForkSB(std::vector<std::array<int, 2>> sa, int m) {
-	std::vector<std::array<int, 2>> forkSB;
-
+void SalMapStentiford::createForkSB(const Fork& sa, int m, RandomGenerator& rng, Fork& forkSB) {
 	// translation lengths in horizontal and vertical coordinates
-	int deltaX = 1 + (rand() % this->hTranslation);
-	int deltaY = 1 + (rand() % this->vTranslation);
+	int deltaX = 1 + rng.uniform(this->hTranslation);
+	int deltaY = 1 + rng.uniform(this->vTranslation);
 
 	// it can be translated in all directions
-	int minusChanceX = rand() % 100;
-	int minusChanceY = rand() % 100;
+	int minusChanceX = rng.uniform(100);
+	int minusChanceY = rng.uniform(100);
 	if (minusChanceX < 50) deltaX *= -1;
 	if (minusChanceY < 50) deltaY *= -1;
 
 	for (int i = 0; i < m; i++) {
 		// save coordinates of pixel to forkSB
-		std::array<int, 2> xy = { this->checkMaxMinWidth(std::get<0>(sa.at(i)) + deltaX),
-								this->checkMaxMinHeight(std::get<1>(sa.at(i)) + deltaY) };
-		forkSB.push_back(xy);
+		forkSB[i][0] = this->checkMaxMinWidth(sa[i][0] + deltaX);
+		forkSB[i][1] = this->checkMaxMinHeight(sa[i][1] + deltaY);
 	}
-
-	return forkSB;
 }
 
 /**
@@ -11,9 +11,12 @@
 #define __SALMAPSTENTIFORD_H__
 
 #include <array>
+#include <vector>
 #include <cmath>
+#include <cstdint>
 #include <opencv2/opencv.hpp>
 #include <opencv2/core.hpp>
+#include "RandomGenerator.h"
 
 using namespace std;
 using namespace cv;
@@ -23,12 +26,29 @@ using namespace cv;
 const int TRANSLATION_DIVIDER = 10;
 // default number of pixels in fork
 const int DEFAULT_M = 3;
+// max number of pixels in fork (forks are arrays on stack)
+const int MAX_M = 16;
 // default max distance of pixels in neighbourhood from actual pixel
 const int DEFAULT_EPS = 1;
 // default number of created forks
 const int DEFAULT_T = 80;
 // default value of threshold
 const int DEFAULT_THRESHOLD = 150;
+// max width or height of image used for computation (larger images are scaled down)
+const float DEFAULT_MAX_SIZE = 400.f;
+// max width or height of image used by faster engine with image-wide forks
+const float SHIFTED_MAX_SIZE = 800.f;
+
+// fork of pixels (only first m pixels are used), coordinates are x,y
+typedef std::array<std::array<int, 2>, MAX_M> Fork;
+
+// fork pattern shared by all pixels: offsets of m pixels from actual pixel and translation of fork SB
+struct ForkPattern
+{
+	Fork offsets;
+	int deltaX;
+	int deltaY;
+};
 
 
 class SalMapStentiford
@@ -40,6 +60,13 @@ public:
 	cv::Mat salMap;
 	// method for generating saliency map with default parameters
 	void generateSalMap(int m = DEFAULT_M, int eps = DEFAULT_EPS, int t = DEFAULT_T, float treshold = DEFAULT_THRESHOLD);
+	// faster method with the same fork patterns for all pixels (evaluated by passes over shifted rows)
+	void generateSalMapShifted(int m = DEFAULT_M, int eps = DEFAULT_EPS, int t = DEFAULT_T, float treshold = DEFAULT_THRESHOLD,
+		float maxSize = SHIFTED_MAX_SIZE);
+	// method for counting mismatching forks of each pixel for defined fork patterns (passes over shifted rows)
+	cv::Mat countShiftedMismatches(const std::vector<ForkPattern>& patterns, int m, float treshold, float maxSize = SHIFTED_MAX_SIZE);
+	// setter of seed for random generators
+	void setSeed(uint64_t seed);
 
 private:
 	// reference for original image
@@ -49,12 +76,22 @@ private:
 	// max distance between forkSA and forkSB in horizontal and verical direction
 	int hTranslation;
 	int vTranslation;
+	// seed for random generators
+	uint64_t seed;
 
 	// method for checking mismatch between two pixels
-	bool mismatchPixels(int x1, int y1, int x2, int y2, float treshold);
+	bool mismatchPixels(int x1, int y1, int x2, int y2, int tresholdSq);
+	// method for converting threshold of distance to threshold of squared distance
+	int squaredThreshold(float treshold);
 	// methods for creating forkSA and forkSB
-	std::vector<std::array<int, 2>> createForkSA(int x1, int y1, int m, int eps);
-	std::vector<std::array<int, 2>> createForkSB(std::vector<std::array<int, 2>> sa, int m);
+	void createForkSA(int x1, int y1, int m, int eps, RandomGenerator& rng, Fork& forkSA);
+	void createForkSB(const Fork& sa, int m, RandomGenerator& rng, Fork& forkSB);
+	// methods for passes over rows of image with image-wide forks
+	void mismatchRow(const uchar* pA, const uchar* pB, int stepB, int n, int tresholdSq, uchar* pMask);
+	void orShiftedRow(const uchar* pMask, int offset, int n, uchar* hit);
+	// methods for scaling image down and saliency map back
+	void scaleDownImage(float maxSize);
+	void scaleBackSalMap(cv::Mat salmapScaled, float maxSize);
 	// methods for watching over limits
 	int checkMaxMinWidth(int pxX);
 	int checkMaxMinHeight(int pxY);
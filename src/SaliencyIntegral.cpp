@@ -0,0 +1,95 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencyIntegral.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "SaliencyIntegral.h"
+
+/**
+ * Default constructor (empty table)
+ */
+SaliencyIntegral::SaliencyIntegral() {
+	this->cols = 0;
+	this->rows = 0;
+	this->table.assign(1, 0);
+}
+
+
+/**
+ * Constructor that computes table of saliency map
+ * @param sm Saliency map CV_8UC1
+ */
+SaliencyIntegral::SaliencyIntegral(cv::Mat sm) {
+	this->compute(sm);
+}
+
+
+/**
+ * Method for computing summed-area table, walking through saliency map row by row
+ * @param sm Saliency map CV_8UC1
+ */
+void SaliencyIntegral::compute(cv::Mat sm) {
+	CV_Assert(sm.type() == CV_8UC1);
+
+	this->cols = sm.cols;
+	this->rows = sm.rows;
+
+	const size_t stride = (size_t)this->cols + 1;
+	// first row and first column stay zero
+	this->table.assign(stride * ((size_t)this->rows + 1), 0);
+
+	for (int j = 0; j < this->rows; j++) {
+		const uint8_t* pSal = sm.ptr<uint8_t>(j);
+		const uint64_t* pAbove = &this->table[(size_t)j * stride];
+		uint64_t* pRow = &this->table[(size_t)(j + 1) * stride];
+
+		// sum of actual row so far + value of table in previous row
+		uint64_t rowSum = 0;
+		for (int i = 0; i < this->cols; i++) {
+			rowSum += pSal[i];
+			pRow[i + 1] = pAbove[i + 1] + rowSum;
+		}
+	}
+}
+
+
+/**
+ * Method for computing average saliency value of one pixel in defined ROI
+ * @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+ * @param y1 Vertical coordinate(y-axis) of ROI top left corner
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @return Average saliency value of ROI in range [0,255]
+ */
+double SaliencyIntegral::mean(int x1, int y1, int w, int h) const {
+	if (w <= 0 || h <= 0)
+		return 0.0;
+
+	return (double)this->sum(x1, y1, w, h) / ((double)w * (double)h);
+}
+
+
+/**
+ * Getter function for total saliency energy of whole saliency map
+ */
+uint64_t SaliencyIntegral::total() const {
+	return this->table.back();
+}
+
+/**
+ * Getter function for width of saliency map
+ */
+int SaliencyIntegral::getWidth() const {
+	return this->cols;
+}
+
+/**
+ * Getter function for height of saliency map
+ */
+int SaliencyIntegral::getHeight() const {
+	return this->rows;
+}
@@ -0,0 +1,72 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencyIntegral.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __SALIENCYINTEGRAL_H__
+#define __SALIENCYINTEGRAL_H__
+
+#include <vector>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ * Summed-area table(integral image) of saliency map CV_8UC1.
+ * It is computed only once for each saliency map and then saliency energy of any ROI is returned in O(1).
+ * 64-bit accumulators are used, so there is no overflow even for very large images.
+ */
+class SaliencyIntegral
+{
+public:
+	// constructors
+	SaliencyIntegral();
+	SaliencyIntegral(cv::Mat sm);
+	// method for (re)computing table of saliency map
+	void compute(cv::Mat sm);
+
+	// saliency energy of defined ROI (ROI must be inside of saliency map)
+	uint64_t sum(int x1, int y1, int w, int h) const;
+	// average saliency value of one pixel in defined ROI
+	double mean(int x1, int y1, int w, int h) const;
+	// total saliency energy of whole saliency map
+	uint64_t total() const;
+
+	// getters of saliency map size
+	int getWidth() const;
+	int getHeight() const;
+
+private:
+	// size of saliency map
+	int cols;
+	int rows;
+	// table with (rows + 1) x (cols + 1) values, first row and column are zeros
+	std::vector<uint64_t> table;
+};
+
+
+/**
+ * Method for computing saliency energy of defined ROI using only 4 values from table
+ * (defined in header, because it is called for every candidate ROI)
+ * @param x1 Horizontal coordinate(x-axis) of ROI top left corner
+ * @param y1 Vertical coordinate(y-axis) of ROI top left corner
+ * @param w Width of ROI
+ * @param h Height of ROI
+ * @return Saliency energy of defined ROI
+ */
+inline uint64_t SaliencyIntegral::sum(int x1, int y1, int w, int h) const {
+	const size_t stride = (size_t)this->cols + 1;
+	const uint64_t* top = &this->table[(size_t)y1 * stride];
+	const uint64_t* bottom = &this->table[(size_t)(y1 + h) * stride];
+
+	return bottom[x1 + w] - bottom[x1] - top[x1 + w] + top[x1];
+}
+
+#endif //__SALIENCYINTEGRAL_H__
@@ -0,0 +1,77 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencyPeakIndex.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "SaliencyPeakIndex.h"
+
+/**
+ * Constructor that sorts pixels of saliency map using bucket sort in O(pixels)
+ * @param sm Saliency map CV_8UC1
+ */
+SaliencyPeakIndex::SaliencyPeakIndex(cv::Mat sm) {
+	CV_Assert(sm.type() == CV_8UC1);
+
+	this->cols = sm.cols;
+	this->cursor = 0;
+
+	// histogram of pixel values
+	size_t bucketStart[256] = { 0 };
+	for (int j = 0; j < sm.rows; j++) {
+		const uint8_t* pSal = sm.ptr<uint8_t>(j);
+		for (int i = 0; i < sm.cols; i++)
+			bucketStart[pSal[i]]++;
+	}
+
+	// buckets are ordered from value 255 to value 0
+	size_t position = 0;
+	for (int v = 255; v >= 0; v--) {
+		size_t count = bucketStart[v];
+		bucketStart[v] = position;
+		position += count;
+	}
+
+	// pixels are walked through in row-major order => the same order inside of each bucket
+	this->order.resize(position);
+	this->values.resize(position);
+	for (int j = 0; j < sm.rows; j++) {
+		const uint8_t* pSal = sm.ptr<uint8_t>(j);
+		for (int i = 0; i < sm.cols; i++) {
+			size_t k = bucketStart[pSal[i]]++;
+			this->order[k] = (uint32_t)j * (uint32_t)sm.cols + (uint32_t)i;
+			this->values[k] = pSal[i];
+		}
+	}
+}
+
+
+/**
+ * Method for finding the highest pixel outside of rectangle. Pixels inside of rectangle are skipped permanently,
+ * so the rectangle must not shrink between calls.
+ * @param x1 Left bound of rectangle (inclusive)
+ * @param y1 Top bound of rectangle (inclusive)
+ * @param x2 Right bound of rectangle (inclusive)
+ * @param y2 Bottom bound of rectangle (inclusive)
+ * @param peak Output position of the highest pixel
+ * @return Value of the highest pixel [0,255] or -1 if all pixels are inside of rectangle
+ */
+int SaliencyPeakIndex::nextPeakOutside(int x1, int y1, int x2, int y2, cv::Point& peak) {
+	while (this->cursor < this->order.size()) {
+		int px = (int)(this->order[this->cursor] % (uint32_t)this->cols);
+		int py = (int)(this->order[this->cursor] / (uint32_t)this->cols);
+
+		if (px < x1 || px > x2 || py < y1 || py > y2) {
+			peak = cv::Point(px, py);
+			return this->values[this->cursor];
+		}
+
+		// pixel is inside of rectangle => it will be inside also in every next call
+		this->cursor++;
+	}
+
+	return -1;
+}
@@ -0,0 +1,46 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencyPeakIndex.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __SALIENCYPEAKINDEX_H__
+#define __SALIENCYPEAKINDEX_H__
+
+#include <vector>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+
+using namespace std;
+using namespace cv;
+
+
+/**
+ * Index of saliency peaks = pixels of saliency map CV_8UC1 sorted from the highest value
+ * (bucket sort with 256 buckets, pixels with the same value are in row-major order like in cv::minMaxLoc).
+ * It is used for growing rectangle: pixels inside of the rectangle are skipped lazily and never visited again,
+ * because the rectangle can only grow.
+ */
+class SaliencyPeakIndex
+{
+public:
+	// constructor
+	SaliencyPeakIndex(cv::Mat sm);
+	// returns value of the highest pixel outside of rectangle [x1,x2] x [y1,y2] (or -1 if there is no such pixel)
+	int nextPeakOutside(int x1, int y1, int x2, int y2, cv::Point& peak);
+
+private:
+	// width of saliency map
+	int cols;
+	// indexes of pixels (y * cols + x) sorted from the highest value
+	std::vector<uint32_t> order;
+	// values of pixels in the same order
+	std::vector<uint8_t> values;
+	// position of the first pixel that was not skipped yet
+	size_t cursor;
+};
+
+#endif //__SALIENCYPEAKINDEX_H__
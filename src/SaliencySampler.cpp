@@ -0,0 +1,90 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencySampler.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "SaliencySampler.h"
+
+/**
+ * Constructor
+ * @param integral Summed-area table of saliency map
+ */
+SaliencySampler::SaliencySampler(const SaliencyIntegral& integral) : integral(integral) {
+}
+
+
+/**
+ * Method for drawing pixel with probability proportional to its saliency value
+ * @param rng Random generator (e.g. generator of actual iteration)
+ * @param px Output horizontal coordinate(x-axis) of pixel
+ * @param py Output vertical coordinate(y-axis) of pixel
+ * @return False if saliency map has no saliency energy, else True
+ */
+bool SaliencySampler::samplePoint(RandomGenerator& rng, int& px, int& py) const {
+	const int cols = this->integral.getWidth();
+	const int rows = this->integral.getHeight();
+	const uint64_t total = this->integral.total();
+	if (total == 0 || cols <= 0 || rows <= 0)
+		return false;
+
+	// random value of saliency energy in range [0,total)
+	uint64_t u = std::min((uint64_t)(rng.uniformReal() * (double)total), total - 1);
+
+	// the first column whose cumulative energy is higher than u
+	int lo = 0, hi = cols - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (this->integral.sum(0, 0, mid + 1, rows) > u)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	px = lo;
+
+	// random value of saliency energy of this column
+	const uint64_t column = this->integral.sum(px, 0, 1, rows);
+	uint64_t v = std::min((uint64_t)(rng.uniformReal() * (double)column), column - 1);
+
+	// the first row whose cumulative energy in this column is higher than v
+	lo = 0;
+	hi = rows - 1;
+	while (lo < hi) {
+		int mid = (lo + hi) / 2;
+		if (this->integral.sum(px, 0, 1, mid + 1) > v)
+			hi = mid;
+		else
+			lo = mid + 1;
+	}
+	py = lo;
+
+	return true;
+}
+
+
+/**
+ * Method for drawing position of window, window contains salient pixel (random position of pixel inside window)
+ * @param rng Random generator (e.g. generator of actual iteration)
+ * @param w Width of window
+ * @param h Height of window
+ * @param x1 Output horizontal coordinate(x-axis) of window top left corner
+ * @param y1 Output vertical coordinate(y-axis) of window top left corner
+ * @return False if window is larger than saliency map or saliency map has no saliency energy, else True
+ */
+bool SaliencySampler::sampleWindow(RandomGenerator& rng, int w, int h, int& x1, int& y1) const {
+	if (w <= 0 || h <= 0 || w > this->integral.getWidth() || h > this->integral.getHeight())
+		return false;
+
+	int px, py;
+	if (!this->samplePoint(rng, px, py))
+		return false;
+
+	// window must stay inside of saliency map
+	x1 = std::min(std::max(px - rng.uniform(w), 0), this->integral.getWidth() - w);
+	y1 = std::min(std::max(py - rng.uniform(h), 0), this->integral.getHeight() - h);
+
+	return true;
+}
@@ -0,0 +1,42 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencySampler.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __SALIENCYSAMPLER_H__
+#define __SALIENCYSAMPLER_H__
+
+#include <algorithm>
+#include "SaliencyIntegral.h"
+#include "RandomGenerator.h"
+
+using namespace std;
+
+
+/**
+ * Importance sampling of cropping windows according to saliency map.
+ * Pixel is drawn with probability proportional to its saliency value: column is found by binary search in cumulative
+ * sums of columns (the last row of summed-area table), row by binary search in cumulative sums of this column.
+ * Window is then placed at random position that contains drawn pixel, so most of windows cover salient regions
+ * and only few samples are wasted on dull parts of image. No other table than summed-area table is needed.
+ */
+class SaliencySampler
+{
+public:
+	// constructor
+	SaliencySampler(const SaliencyIntegral& integral);
+	// draws pixel with probability proportional to its saliency (returns false if saliency map is empty)
+	bool samplePoint(RandomGenerator& rng, int& px, int& py) const;
+	// draws position of window with defined size, window contains pixel drawn by samplePoint
+	bool sampleWindow(RandomGenerator& rng, int w, int h, int& x1, int& y1) const;
+
+private:
+	// summed-area table of saliency map
+	const SaliencyIntegral& integral;
+};
+
+#endif //__SALIENCYSAMPLER_H__
@@ -0,0 +1,47 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencyScorer.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "SaliencyScorer.h"
+
+/**
+ * Constructor
+ * @param integral Summed-area table of saliency map
+ * @param measure Computed measure (SALIENCY_RATIO => content column, SALIENCY_MEAN => attention column)
+ */
+SaliencyScorer::SaliencyScorer(const SaliencyIntegral& integral, SaliencyMeasure measure) : integral(integral), measure(measure) {
+}
+
+
+/**
+ * Method for computing saliency measure of all candidates in batch
+ * @param batch Batch of candidates (inside of saliency map)
+ */
+void SaliencyScorer::score(CandidateBatch& batch) {
+	const int count = batch.size();
+	std::vector<double>& scores = (this->measure == SALIENCY_RATIO) ? batch.content : batch.attention;
+	scores.resize(count);
+
+	const int* px = batch.x.data();
+	const int* py = batch.y.data();
+	const int* pw = batch.width.data();
+	const int* ph = batch.height.data();
+	double* pScores = scores.data();
+
+	if (this->measure == SALIENCY_RATIO) {
+		const double total = (double)this->integral.total();
+#pragma omp parallel for
+		for (int i = 0; i < count; i++)
+			pScores[i] = (double)this->integral.sum(px[i], py[i], pw[i], ph[i]) / total;
+	}
+	else {
+#pragma omp parallel for
+		for (int i = 0; i < count; i++)
+			pScores[i] = this->integral.mean(px[i], py[i], pw[i], ph[i]);
+	}
+}
@@ -0,0 +1,41 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SaliencyScorer.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __SALIENCYSCORER_H__
+#define __SALIENCYSCORER_H__
+
+#include "CandidateScorer.h"
+#include "SaliencyIntegral.h"
+
+/* measures of saliency of candidate */
+enum SaliencyMeasure {
+	SALIENCY_RATIO,	// ratio of saliency energy of ROI and whole image => content column
+	SALIENCY_MEAN	// average saliency value of pixel in ROI => attention column
+};
+
+
+/**
+ * Scorer of saliency of candidates (content preservation model or Stentiford's average attention score).
+ * Each candidate costs 4 lookups in summed-area table.
+ */
+class SaliencyScorer : public CandidateScorer
+{
+public:
+	// constructor
+	SaliencyScorer(const SaliencyIntegral& integral, SaliencyMeasure measure);
+	void score(CandidateBatch& batch);
+
+private:
+	// summed-area table of saliency map
+	const SaliencyIntegral& integral;
+	// computed measure
+	SaliencyMeasure measure;
+};
+
+#endif //__SALIENCYSCORER_H__
@@ -0,0 +1,103 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: TopKWindows.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#include "TopKWindows.h"
+
+/**
+ * Method for inserting all windows of other pool (used for merging private pools of threads)
+ * @param other Pool of windows
+ */
+void TopKWindows::merge(const TopKWindows& other) {
+	for (std::set<ScoredWindow, WindowOrder>::const_iterator it = other.windows.begin(); it != other.windows.end(); it++)
+		this->push(*it);
+}
+
+
+/**
+ * Method for removing all windows from pool (capacity stays the same)
+ */
+void TopKWindows::clear() {
+	this->windows.clear();
+	this->regions.clear();
+}
+
+
+/**
+ * Method for creating empty pool with the same parameters (used for private pools of threads)
+ * @return Empty pool with the same capacity and size of cells
+ */
+TopKWindows TopKWindows::emptyCopy() const {
+	return TopKWindows(this->capacity, this->cellWidth, this->cellHeight);
+}
+
+
+/**
+ * Getter function for maximal number of kept windows
+ */
+int TopKWindows::getCapacity() const {
+	return this->capacity;
+}
+
+
+/**
+ * Method for sorting kept windows
+ * @return Windows sorted from the best one
+ */
+std::vector<ScoredWindow> TopKWindows::sorted() const {
+	return std::vector<ScoredWindow>(this->windows.begin(), this->windows.end());
+}
+
+
+/**
+ * Method for selecting distinct windows by greedy non-maximum suppression
+ * @param k Maximal number of selected windows
+ * @param first Windows that are selected before windows from pool (e.g. final crop of algorithm)
+ * @param maxIoU Maximal intersection over union of selected window and any previously selected window
+ * @return Selected windows, windows from pool are sorted from the best one
+ */
+std::vector<ScoredWindow> TopKWindows::suppress(int k, std::vector<ScoredWindow> first, double maxIoU) const {
+	std::vector<ScoredWindow> selected;
+	for (size_t i = 0; i < first.size() && (int)selected.size() < k; i++)
+		selected.push_back(first[i]);
+
+	// windows from the best one
+	std::vector<ScoredWindow> sorted = this->sorted();
+
+	for (size_t i = 0; i < sorted.size() && (int)selected.size() < k; i++) {
+		// window is skipped if it overlaps too much with any selected window
+		bool distinct = true;
+		for (size_t j = 0; j < selected.size() && distinct; j++) {
+			if (TopKWindows::intersectionOverUnion(sorted[i], selected[j]) > maxIoU)
+				distinct = false;
+		}
+
+		if (distinct)
+			selected.push_back(sorted[i]);
+	}
+
+	return selected;
+}
+
+
+/**
+ * Method for computing intersection over union of two windows
+ * @param a First window
+ * @param b Second window
+ * @return Area of intersection / area of union in range [0,1]
+ */
+double TopKWindows::intersectionOverUnion(const ScoredWindow& a, const ScoredWindow& b) {
+	int iw = std::min(a.x + a.width, b.x + b.width) - std::max(a.x, b.x);
+	int ih = std::min(a.y + a.height, b.y + b.height) - std::max(a.y, b.y);
+	if (iw <= 0 || ih <= 0)
+		return 0.0;
+
+	double intersection = (double)iw * (double)ih;
+	double areaUnion = (double)a.width * a.height + (double)b.width * b.height - intersection;
+	return intersection / areaUnion;
+}
@@ -0,0 +1,125 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: TopKWindows.h
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+#ifndef __TOPKWINDOWS_H__
+#define __TOPKWINDOWS_H__
+
+#include <vector>
+#include <set>
+#include <unordered_map>
+#include <cstdint>
+#include <algorithm>
+#include "ParallelReduction.h"
+
+using namespace std;
+
+/* number of windows kept in pool for one requested crop (pool is larger than k, because NMS removes overlapping windows) */
+const int TOPK_POOL_FACTOR = 32;
+/* maximal intersection over union of two returned crops */
+const double TOPK_MAX_IOU = 0.5;
+/* number of regions in each axis of image, pool keeps only the best window of each region */
+const int TOPK_REGIONS = 16;
+
+
+/**
+ * Bounded pool of the best windows (ordered set with the worst kept window at the end, so most of windows are rejected in O(1)).
+ * Optionally the pool keeps at most one window per region: windows with all four edges in the same cells of grid
+ * cellWidth x cellHeight are shifts of one window by less than one cell, only the best of them is kept. So the pool is not
+ * filled with small shifts of the winner and distinct windows survive until non-maximum suppression.
+ * Each thread fills its own pool and pools are merged at the end:
+ *   TopKWindows pool = this->topWindows.emptyCopy();
+ *   #pragma omp parallel for reduction(topWindows : pool)
+ * Pool keeps the best windows of the best regions in total order of ScoredWindow, so its content is identical for any number
+ * of threads. Distinct crops are then selected by greedy non-maximum suppression (IoU of two selected crops is at most maxIoU).
+ */
+class TopKWindows
+{
+public:
+	// constructor (pool with zero capacity ignores all windows, zero size of cell => windows are not grouped to regions)
+	TopKWindows(int capacity = 0, int cellWidth = 0, int cellHeight = 0)
+		: capacity(capacity), cellWidth(std::max(0, cellWidth)), cellHeight(std::max(0, cellHeight)) {}
+
+	// inserts window to pool if it is better than the worst kept window (and the best window of its region)
+	void push(const ScoredWindow& window) {
+		if (this->capacity <= 0 || !window.isValid())
+			return;
+		// the most of windows is rejected here
+		if ((int)this->windows.size() >= this->capacity && !window.isBetterThan(*this->windows.rbegin()))
+			return;
+
+		if (this->cellWidth > 0 && this->cellHeight > 0) {
+			uint64_t key = this->regionKey(window);
+			std::unordered_map<uint64_t, ScoredWindow>::iterator it = this->regions.find(key);
+			if (it != this->regions.end()) {
+				// only the best window of region is kept
+				if (!window.isBetterThan(it->second))
+					return;
+				this->windows.erase(it->second);
+				it->second = window;
+				this->windows.insert(window);
+				return;
+			}
+			this->regions[key] = window;
+		}
+
+		this->windows.insert(window);
+		if ((int)this->windows.size() > this->capacity) {
+			std::set<ScoredWindow, WindowOrder>::iterator worst = std::prev(this->windows.end());
+			if (this->cellWidth > 0 && this->cellHeight > 0)
+				this->regions.erase(this->regionKey(*worst));
+			this->windows.erase(worst);
+		}
+	}
+
+	// inserts all windows of other pool
+	void merge(const TopKWindows& other);
+	// removes all windows
+	void clear();
+	// returns empty pool with the same capacity and regions (e.g. private pool of thread)
+	TopKWindows emptyCopy() const;
+	int getCapacity() const;
+	// returns all kept windows sorted from the best one
+	std::vector<ScoredWindow> sorted() const;
+	// selects up to k distinct windows from the best one, selection starts with windows in vector first
+	std::vector<ScoredWindow> suppress(int k, std::vector<ScoredWindow> first = std::vector<ScoredWindow>(), double maxIoU = TOPK_MAX_IOU) const;
+	// intersection over union of two windows
+	static double intersectionOverUnion(const ScoredWindow& a, const ScoredWindow& b);
+
+private:
+	// total order of windows from the best one
+	struct WindowOrder {
+		bool operator()(const ScoredWindow& a, const ScoredWindow& b) const {
+			return a.isBetterThan(b);
+		}
+	};
+
+	// maximal number of kept windows
+	int capacity;
+	// size of cell of grid that defines regions (0 => no regions)
+	int cellWidth;
+	int cellHeight;
+	// kept windows sorted from the best one (the worst window is at the end)
+	std::set<ScoredWindow, WindowOrder> windows;
+	// kept window of each region
+	std::unordered_map<uint64_t, ScoredWindow> regions;
+
+	// region of window = cells of its left, top, right and bottom edge
+	uint64_t regionKey(const ScoredWindow& w) const {
+		return ((uint64_t)(w.x / this->cellWidth) << 48) | ((uint64_t)(w.y / this->cellHeight) << 32) |
+			((uint64_t)((w.x + w.width) / this->cellWidth) << 16) | (uint64_t)((w.y + w.height) / this->cellHeight);
+	}
+};
+
+
+/**
+ * Merging of private pools in OpenMP loops (private pools have the same capacity and regions as original pool)
+ */
+#pragma omp declare reduction(topWindows : TopKWindows : omp_out.merge(omp_in)) initializer(omp_priv = omp_orig.emptyCopy())
+
+#endif //__TOPKWINDOWS_H__
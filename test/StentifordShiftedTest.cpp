@@ -0,0 +1,109 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: StentifordShiftedTest.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+/**
+ * Test of faster engine of Stentiford's saliency map: passes over shifted rows (countShiftedMismatches) must give
+ * the same number of mismatching forks as direct evaluation of the same fork patterns for every pixel.
+ * Translations longer than image and offsets out of image test clamping at all borders.
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include <opencv2/opencv.hpp>
+#include "../src/SalMapStentiford.h"
+
+/* size of random image (not divisible by SIMD width), threshold and number of fork patterns */
+const int COLS = 37;
+const int ROWS = 23;
+const float TRESHOLD = 150.f;
+const int PATTERNS = 60;
+
+int failures = 0;
+
+void check(bool condition, const char* message) {
+	if (!condition) {
+		std::cerr << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+
+int main() {
+	std::mt19937 generator(7);
+	std::uniform_int_distribution<int> value(0, 255);
+
+	// random image with flat areas (pixels are copied from left neighbour), so both mismatches and matches occur
+	cv::Mat image(ROWS, COLS, CV_8UC3);
+	for (int j = 0; j < ROWS; j++) {
+		uchar* p = image.ptr<uchar>(j);
+		for (int i = 0; i < COLS; i++) {
+			bool copy = i > 0 && value(generator) < 128;
+			for (int c = 0; c < 3; c++)
+				p[3 * i + c] = copy ? p[3 * (i - 1) + c] : (uchar)value(generator);
+		}
+	}
+
+	for (int m : { 1, 3, MAX_M }) {
+		// fixed patterns with offsets up to 3 pixels and translations up to 2x size of image in both directions
+		std::vector<ForkPattern> patterns(PATTERNS);
+		std::uniform_int_distribution<int> offset(-3, 3);
+		std::uniform_int_distribution<int> deltaX(-2 * COLS, 2 * COLS);
+		std::uniform_int_distribution<int> deltaY(-2 * ROWS, 2 * ROWS);
+		for (ForkPattern& pattern : patterns) {
+			for (int k = 0; k < m; k++) {
+				pattern.offsets[k][0] = offset(generator);
+				pattern.offsets[k][1] = offset(generator);
+			}
+			pattern.deltaX = deltaX(generator);
+			pattern.deltaY = deltaY(generator);
+		}
+
+		SalMapStentiford stentiford(image);
+		cv::Mat counts = stentiford.countShiftedMismatches(patterns, m, TRESHOLD);
+		check(counts.rows == ROWS && counts.cols == COLS && counts.type() == CV_32SC1, "counts have wrong size or type");
+		if (counts.rows != ROWS || counts.cols != COLS)
+			continue;
+
+		// direct evaluation of every fork of every pixel (positions are clamped to image, distance is L2 norm)
+		auto clampX = [](int x) { return std::min(std::max(x, 0), COLS - 1); };
+		auto clampY = [](int y) { return std::min(std::max(y, 0), ROWS - 1); };
+		int differences = 0;
+		for (int y = 0; y < ROWS; y++) {
+			for (int x = 0; x < COLS; x++) {
+				int expected = 0;
+				for (const ForkPattern& pattern : patterns) {
+					bool mismatch = false;
+					for (int k = 0; k < m; k++) {
+						int ax = clampX(x + pattern.offsets[k][0]);
+						int ay = clampY(y + pattern.offsets[k][1]);
+						int bx = clampX(ax + pattern.deltaX);
+						int by = clampY(ay + pattern.deltaY);
+						const uchar* a = image.ptr<uchar>(ay) + 3 * ax;
+						const uchar* b = image.ptr<uchar>(by) + 3 * bx;
+						double distance = 0.0;
+						for (int c = 0; c < 3; c++)
+							distance += (double)(a[c] - b[c]) * (a[c] - b[c]);
+						mismatch = mismatch || std::sqrt(distance) > TRESHOLD;
+					}
+					expected += mismatch ? 1 : 0;
+				}
+				if (counts.at<int>(y, x) != expected)
+					differences++;
+			}
+		}
+		check(differences == 0, "shifted evaluation differs from direct evaluation");
+	}
+
+	if (failures > 0)
+		return 1;
+	std::cout << "StentifordShiftedTest: shifted and direct evaluation are identical" << std::endl;
+	return 0;
+}
@@ -0,0 +1,99 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: SuhExactGeneralTest.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+/**
+ * Test of exact search in Suh's algorithm: exactGeneral must return ROI with the smallest area whose saliency energy
+ * satisfies treshold, the same area as exhaustive enumeration of all ROIs in pixels (for 1px grid and for coarser grid).
+ */
+
+#include <iostream>
+#include <vector>
+#include <random>
+#include <cmath>
+#include <cstdint>
+#include <opencv2/opencv.hpp>
+#include "../src/AutocropSuh.h"
+
+/* size of random saliency maps and their number */
+const int COLS = 40;
+const int ROWS = 30;
+const int MAPS = 10;
+
+int failures = 0;
+
+void check(bool condition, const char* message) {
+	if (!condition) {
+		std::cerr << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+
+int main() {
+	std::mt19937 generator(42);
+	std::uniform_int_distribution<int> value(0, 255);
+	std::uniform_int_distribution<int> hot(0, 9);
+
+	const float tresholds[] = { 0.3f, 0.6f, 0.9f };
+	const int steps[][2] = { { 1, 1 }, { 4, 3 } };
+
+	for (int m = 0; m < MAPS; m++) {
+		// sparse random saliency map (most of pixels are zero, so the smallest ROI is not the whole map)
+		cv::Mat salmap(ROWS, COLS, CV_8UC1);
+		for (int j = 0; j < ROWS; j++)
+			for (int i = 0; i < COLS; i++)
+				salmap.at<uchar>(j, i) = (hot(generator) == 0) ? (uchar)value(generator) : 0;
+
+		// summed-area table of map
+		std::vector<uint64_t> table((size_t)(COLS + 1) * (ROWS + 1), 0);
+		for (int j = 0; j < ROWS; j++) {
+			uint64_t rowSum = 0;
+			for (int i = 0; i < COLS; i++) {
+				rowSum += salmap.at<uchar>(j, i);
+				table[(size_t)(j + 1) * (COLS + 1) + i + 1] = table[(size_t)j * (COLS + 1) + i + 1] + rowSum;
+			}
+		}
+		auto sum = [&table](int x, int y, int w, int h) -> uint64_t {
+			const size_t stride = COLS + 1;
+			return table[(size_t)(y + h) * stride + x + w] - table[(size_t)y * stride + x + w] -
+				table[(size_t)(y + h) * stride + x] + table[(size_t)y * stride + x];
+		};
+		const uint64_t total = sum(0, 0, COLS, ROWS);
+		const int minWidth = std::max(1, (int)(MAX_SCALE_SUH * COLS));
+		const int minHeight = std::max(1, (int)(MAX_SCALE_SUH * ROWS));
+
+		for (float treshold : tresholds) {
+			// the smallest area by exhaustive enumeration of all ROIs
+			const uint64_t tresholdSum = (uint64_t)std::ceil((double)treshold * (double)total);
+			long long bestArea = -1;
+			for (int h = minHeight; h <= ROWS; h++)
+				for (int w = minWidth; w <= COLS; w++)
+					for (int y = 0; y + h <= ROWS; y++)
+						for (int x = 0; x + w <= COLS; x++)
+							if (sum(x, y, w, h) >= tresholdSum && (bestArea < 0 || (long long)w * h < bestArea))
+								bestArea = (long long)w * h;
+
+			for (const auto& step : steps) {
+				AutocropSuh suh(salmap);
+				suh.exactGeneral(treshold, step[0], step[1]);
+				const int x = suh.getX(), y = suh.getY(), w = suh.getWidth(), h = suh.getHeight();
+
+				check(x >= 0 && y >= 0 && x + w <= COLS && y + h <= ROWS, "ROI is not inside of saliency map");
+				check(w >= minWidth && h >= minHeight, "ROI is smaller than minimal size");
+				check(sum(x, y, w, h) >= tresholdSum, "ROI does not satisfy treshold");
+				check((long long)w * h == bestArea, "ROI does not have the smallest area");
+			}
+		}
+	}
+
+	if (failures > 0)
+		return 1;
+	std::cout << "SuhExactGeneralTest: " << MAPS << " maps passed" << std::endl;
+	return 0;
+}
@@ -0,0 +1,96 @@
+/**
+ * Bachelor thesis: Algorithms for automatic image cropping
+ * VUT FIT 2018
+ * Author: Vít Ambrož (xambro15@stud.fit.vutbr.cz)
+ * Supervisor: Doc. Ing. Martin Čadík, Ph. D.
+ * File: TopKWindowsTest.cpp
+ * Github repository: https://github.com/VitaAmbroz/AutoCropApp
+ */
+
+/**
+ * Test of top-k crops: grid search (step 1% of image) on smooth saliency map must return k distinct crops
+ * and the pool must be the same for any order of merged private pools.
+ */
+
+#include <iostream>
+#include <vector>
+#include <cmath>
+#include <cstdint>
+#include "../src/TopKWindows.h"
+
+/* size of saliency map, size of crop and number of requested crops */
+const int COLS = 3000;
+const int ROWS = 2000;
+const int CROP_W = 600;
+const int CROP_H = 400;
+const int K = 5;
+
+int failures = 0;
+
+void check(bool condition, const char* message) {
+	if (!condition) {
+		std::cerr << "FAILED: " << message << std::endl;
+		failures++;
+	}
+}
+
+
+int main() {
+	// smooth saliency map (one gaussian blob in the middle) and its summed-area table
+	std::vector<uint64_t> table((size_t)(COLS + 1) * (ROWS + 1), 0);
+	for (int j = 0; j < ROWS; j++) {
+		uint64_t rowSum = 0;
+		for (int i = 0; i < COLS; i++) {
+			double dx = (i - COLS / 2) / 400.0;
+			double dy = (j - ROWS / 2) / 300.0;
+			rowSum += (uint64_t)(255.0 * std::exp(-0.5 * (dx * dx + dy * dy)));
+			table[(size_t)(j + 1) * (COLS + 1) + i + 1] = table[(size_t)j * (COLS + 1) + i + 1] + rowSum;
+		}
+	}
+	auto sum = [&table](int x, int y, int w, int h) -> double {
+		const size_t stride = COLS + 1;
+		return (double)(table[(size_t)(y + h) * stride + x + w] - table[(size_t)y * stride + x + w] -
+			table[(size_t)(y + h) * stride + x] + table[(size_t)y * stride + x]);
+	};
+
+	// the same pool as croppers use for -topk K, the grid is walked by 4 private pools
+	const int hStep = COLS / 100;
+	const int vStep = ROWS / 100;
+	TopKWindows pool(K * TOPK_POOL_FACTOR, COLS / TOPK_REGIONS, ROWS / TOPK_REGIONS);
+	std::vector<TopKWindows> parts(4, pool.emptyCopy());
+	ScoredWindow best;
+	int n = 0;
+	for (int y = 0; y + CROP_H <= ROWS; y += vStep) {
+		for (int x = 0; x + CROP_W <= COLS; x += hStep) {
+			ScoredWindow window(sum(x, y, CROP_W, CROP_H), x, y, CROP_W, CROP_H);
+			best.update(window);
+			parts[n++ % 4].push(window);
+		}
+	}
+	TopKWindows forward = pool.emptyCopy();
+	TopKWindows backward = pool.emptyCopy();
+	for (int i = 0; i < 4; i++) {
+		forward.merge(parts[i]);
+		backward.merge(parts[3 - i]);
+	}
+
+	// content of pool does not depend on order of merging
+	std::vector<ScoredWindow> a = forward.sorted();
+	std::vector<ScoredWindow> b = backward.sorted();
+	check(a.size() == b.size(), "pools merged in different order have different size");
+	for (size_t i = 0; i < a.size() && i < b.size(); i++)
+		check(a[i].x == b[i].x && a[i].y == b[i].y && a[i].score == b[i].score, "pools merged in different order differ");
+
+	// K distinct crops, the first one is the best window
+	std::vector<ScoredWindow> first(1, best);
+	std::vector<ScoredWindow> crops = forward.suppress(K, first);
+	check((int)crops.size() == K, "less than K distinct crops were returned");
+	for (size_t i = 0; i < crops.size(); i++)
+		for (size_t j = i + 1; j < crops.size(); j++)
+			check(TopKWindows::intersectionOverUnion(crops[i], crops[j]) <= TOPK_MAX_IOU, "returned crops overlap too much");
+
+	if (failures > 0)
+		return 1;
+	std::cout << "TopKWindowsTest: " << crops.size() << " distinct crops" << std::endl;
+	return 0;
+}